@@ -19,16 +19,62 @@
 *	next and prev pointers) and that given that it is a circular
 *	linked deque the last link points to the sentinel and the first
 *	link points to the last link -- instead of null.
+*
+*	The deque also carries a direction bit. While it is set,
+*	the deque's front is the link before the sentinel and its
+*	values run through prev pointers, so every operation reads
+*	next and prev swapped and reversing the deque is O(1): it
+*	just flips the bit.
+*
+*	For round-robin use the deque keeps one cursor, a link it
+*	walks in place: circularListNext steps it forward (in the
+*	deque's direction), wrapping from the back to the front
+*	and skipping the sentinel, and values can be removed or
+*	inserted at it, all without allocating anything besides
+*	the inserted link. A cursor on the sentinel stands for the
+*	front link, whichever it is: that is where a new deque's
+*	cursor starts, and where it lands when the back link it was
+*	on is removed, since removing the cursor's link by any means
+*	moves the cursor on to the following link. Every cursor
+*	function reads that state as the front (cursorLink).
+*	circularListRotate moves the sentinel instead of any values.
+*
+*	A deque made with circularListCreateBounded holds at most
+*	capacity values, in links preallocated as one array and
+*	recycled through a spare list, so it never allocates after
+*	creation. Adding to a full deque overwrites the value at
+*	the other end in place and rotates the sentinel past it:
+*	AddBack replaces the front (the oldest value, for a deque
+*	only added to at the back), AddFront replaces the back.
+*	The cursor treats every overwrite as a removal followed by
+*	an add: a cursor on the replaced value moves on to the
+*	following link, as it does when InsertAtCursor evicts the
+*	front to make room. circularListExport copies the values
+*	out front to back.
+*
+*	circularListCreateWithAllocator takes the deque's header,
+*	sentinel and links from the caller's allocator (see
+*	allocator.h) instead of malloc.
 ************************************************************/
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <math.h>
 #include <assert.h>
 #include "circularList.h"
+#include "../printBuffer.h"
 
 #ifndef FORMAT_SPECIFIER
 #define FORMAT_SPECIFIER "%g"
 #endif
 
+/* writes V's text at char* P (at most PRINT_VALUE_MAX chars), returns its length;
+   must agree with FORMAT_SPECIFIER */
+#ifndef FORMAT_VALUE
+#define FORMAT_VALUE(P, V) formatDouble((P), (double)(V))
+#endif
+#define PRINT_VALUE_MAX 64
+
 // Double link
 struct Link
 {
@@ -41,6 +87,12 @@ struct CircularList
 {
 	int size;
 	struct Link* sentinel;
+	int reversed;					// nonzero if the front is sentinel->prev
+	struct Link* cursor;			// link at the cursor; the sentinel stands for the front
+	int capacity;					// most values a bounded deque holds; 0 if unbounded
+	struct Link* nodes;				// a bounded deque's preallocated links, or NULL
+	struct Link* spare;				// unused preallocated links, chained through next
+	struct Allocator allocator;		// source of the header, sentinel and links
 };
 
 /* FIXME: You will write this function */
@@ -57,7 +109,8 @@ struct CircularList
 static void init(struct CircularList* deque)
 {
 	/* allocate memory for the CircularList's sentinel */
-	struct Link* sentinel = (struct Link*)malloc(sizeof(struct Link));
+	struct Link* sentinel = deque->allocator.alloc(deque->allocator.context, sizeof(struct Link));
+	assert(sentinel != 0);
 
 	/* point the CircularList's sentinel pointer to the above link/node for a sentinel */
 	deque->sentinel = sentinel;
@@ -66,21 +119,81 @@ static void init(struct CircularList* deque)
 	sentinel->value = 0;
 	sentinel->next = sentinel;
 	sentinel->prev = sentinel;
+	deque->size = 0;
+	deque->reversed = 0;
+	deque->cursor = sentinel;
+	deque->capacity = 0;
+	deque->nodes = 0;
+	deque->spare = 0;
+}
+
+/**
+	Returns the link after the given one in the deque's current
+	direction (front to back); the sentinel follows the back link.
+	param: 	deque 	struct CircularList ptr
+ 	param:	link 	struct Link ptr in the deque
+ */
+static struct Link* forward(struct CircularList* deque, struct Link* link)
+{
+	return deque->reversed ? link->prev : link->next;
+}
+
+/**
+	Returns the link before the given one in the deque's current
+	direction; the sentinel precedes the front link.
+	param: 	deque 	struct CircularList ptr
+ 	param:	link 	struct Link ptr in the deque
+ */
+static struct Link* backward(struct CircularList* deque, struct Link* link)
+{
+	return deque->reversed ? link->next : link->prev;
+}
+
+/**
+	Takes the sentinel out of the ring and puts it back just before
+	the given link (in the deque's direction), which becomes the front.
+	param: 	deque 	struct CircularList ptr
+	param:	front	struct Link ptr in the deque, not the sentinel
+ */
+static void moveSentinelBefore(struct CircularList* deque, struct Link* front)
+{
+	struct Link* sentinel = deque->sentinel;
+	assert(front != sentinel);
+
+	sentinel->prev->next = sentinel->next;
+	sentinel->next->prev = sentinel->prev;
+	struct Link* after = deque->reversed ? front : front->prev;
+	sentinel->prev = after;
+	sentinel->next = after->next;
+	after->next->prev = sentinel;
+	after->next = sentinel;
 }
 
 /* FIXME: You will write this function */
 /**
 	Creates a link with the given value and NULL next and prev pointers.
+	param: 	deque 	struct CircularList ptr whose allocator is used
 	param: 	value 	TYPE
-	pre: 	none
+	pre: 	deque is not null
 	post: 	newLink is not null
 			newLink value init to value 
 			newLink next and prev init to NULL
  */
-static struct Link* createLink(TYPE value)
+static struct Link* createLink(struct CircularList* deque, TYPE value)
 {
-	/* create a new node/link */
-	struct Link* node = (struct Link*)malloc(sizeof(struct Link));
+	/* create a new node/link (a bounded deque takes a spare one) */
+	struct Link* node;
+	if (deque->nodes != 0)
+	{
+		node = deque->spare;
+		assert(node != 0);
+		deque->spare = node->next;
+	}
+	else
+	{
+		node = deque->allocator.alloc(deque->allocator.context, sizeof(struct Link));
+		assert(node != 0);
+	}
 	node->value = value;
 
 	/* update pointers to NULL */
@@ -110,7 +223,7 @@ static void addLinkAfter(struct CircularList* deque, struct Link* link, TYPE val
 	assert(link != 0);
 
 	/* initialize the new node/link */
-	struct Link* node = createLink(value);
+	struct Link* node = createLink(deque, value);
 
 	/* create a pointer to the other node/link that the new node/link must be inserted between */
 	struct Link* temp = link->next;
@@ -141,12 +254,26 @@ static void removeLink(struct CircularList* deque, struct Link* link)
 	assert(deque != 0);
 	assert(link != 0);
 
+	/* a cursor on the removed link moves on to the following one */
+	if (deque->cursor == link)
+	{
+		deque->cursor = forward(deque, link);
+	}
+
 	/* update the pointers of the nodes/links before/after the link that will be removed */
 	link->next->prev = link->prev;
 	link->prev->next = link->next;
 
-	/* free the removed node/link's memory */
-	free(link);
+	/* free the removed node/link's memory (a bounded deque keeps it as a spare) */
+	if (deque->nodes != 0)
+	{
+		link->next = deque->spare;
+		deque->spare = link;
+	}
+	else
+	{
+		deque->allocator.free(deque->allocator.context, link, sizeof(struct Link));
+	}
 
 	/* decrement the deque's size by 1 */
 	deque->size -= 1;
@@ -161,11 +288,60 @@ static void removeLink(struct CircularList* deque, struct Link* link)
  */
 struct CircularList* circularListCreate()
 {
-	struct CircularList* deque = (struct CircularList*)malloc(sizeof(struct CircularList));
+	return circularListCreateWithAllocator(0);
+}
+
+/**
+	Allocates and initializes a deque whose header, sentinel and
+	links come from the given allocator.
+	param:	allocator	struct Allocator ptr, copied; NULL for malloc
+	pre: 	none
+	post: 	memory allocated for new struct CircularList ptr
+			deque init (call to init func)
+	return: deque
+ */
+struct CircularList* circularListCreateWithAllocator(const struct Allocator* allocator)
+{
+	struct Allocator source = allocator != 0 ? *allocator : allocatorMalloc();
+	assert(source.alloc != 0 && source.free != 0);
+
+	struct CircularList* deque = source.alloc(source.context, sizeof(struct CircularList));
+	assert(deque != 0);
+	deque->allocator = source;
 	init(deque);
 	return deque;
 }
 
+/**
+	Allocates and initializes a deque that holds at most capacity
+	values, with all of its links allocated up front in one array.
+	Once full, adding at one end overwrites the value at the other
+	end instead of allocating (see circularListAddBack).
+	param:	capacity	most values the deque holds
+	param:	allocator	struct Allocator ptr, copied; NULL for malloc
+	pre: 	capacity > 0
+	post: 	memory allocated for new struct CircularList ptr and for
+			capacity links
+	return: deque
+ */
+struct CircularList* circularListCreateBounded(int capacity, const struct Allocator* allocator)
+{
+	assert(capacity > 0);
+	struct CircularList* deque = circularListCreateWithAllocator(allocator);
+
+	deque->nodes = deque->allocator.alloc(deque->allocator.context, (size_t)capacity * sizeof(struct Link));
+	assert(deque->nodes != 0);
+	deque->capacity = capacity;
+
+	/* chain the links in array order, so a filling deque walks memory forward */
+	for (int i = 0; i < capacity; i++)
+	{
+		deque->nodes[i].next = (i + 1 < capacity) ? &deque->nodes[i + 1] : 0;
+	}
+	deque->spare = deque->nodes;
+	return deque;
+}
+
 /* FIXME: You will write this function */
 /**
 	Deallocates every link in the deque and frees the deque pointer.
@@ -183,19 +359,28 @@ void circularListDestroy(struct CircularList* deque)
 	struct Link* node = deque->sentinel->next;
 	struct Link* temp = deque->sentinel->next;
 
+	struct Allocator allocator = deque->allocator;
+
+	/* a bounded deque's links are all in one array */
+	if (deque->nodes != 0)
+	{
+		allocator.free(allocator.context, deque->nodes, (size_t)deque->capacity * sizeof(struct Link));
+		node = temp = deque->sentinel;
+	}
+
 	/* iterate through the list & free each link/node */
 	while (node != deque->sentinel)
 	{
 		node = node->next;
-		free(temp);
+		allocator.free(allocator.context, temp, sizeof(struct Link));
 		temp = node;
 	}
 
 	/* free the sentinel */
-	free(deque->sentinel);
+	allocator.free(allocator.context, deque->sentinel, sizeof(struct Link));
 
 	/* free the pointer to the deque */
-	free(deque);
+	allocator.free(allocator.context, deque, sizeof(struct CircularList));
 }
 
 /* FIXME: You will write this function */
@@ -206,14 +391,34 @@ void circularListDestroy(struct CircularList* deque)
 	pre: 	deque is not null
 	post: 	link is created w/ given value before current first link
 			(call to addLinkAfter)
+	post:	if the deque is bounded and full, the back value is
+			overwritten with value and becomes the front instead;
+			a cursor on it wraps to the front, as if the back had
+			been removed
  */
 void circularListAddFront(struct CircularList* deque, TYPE value)
 {
 	/* assert to validate the deque is not NULL */
 	assert(deque != 0);
 
-	/* insert new node/link after the sentinel */
-	addLinkAfter(deque, deque->sentinel, value);
+	/* a full bounded deque reuses its back link as the new front */
+	if (deque->size == deque->capacity && deque->nodes != 0)
+	{
+		struct Link* back = backward(deque, deque->sentinel);
+		if (deque->cursor == back)
+		{
+			deque->cursor = deque->sentinel;
+		}
+		back->value = value;
+		if (deque->size > 1)
+		{
+			moveSentinelBefore(deque, back);
+		}
+		return;
+	}
+
+	/* insert new node/link after the sentinel (in the deque's direction) */
+	addLinkAfter(deque, deque->reversed ? deque->sentinel->prev : deque->sentinel, value);
 }
 
 /* FIXME: You will write this function */
@@ -224,14 +429,34 @@ void circularListAddFront(struct CircularList* deque, TYPE value)
 	pre: 	deque is not null
 	post: 	link is created w/ given value before current last link
 			(call to addLinkAfter)
+	post:	if the deque is bounded and full, the front (oldest) value
+			is overwritten with value and becomes the back instead;
+			a cursor on it moves on to the following value, as if the
+			front had been removed
  */
 void circularListAddBack(struct CircularList* deque, TYPE value)
 {
 	/* assert to validate the deque is not NULL */
 	assert(deque != 0);
 
-	/* insert a new node/link before the sentinel (after the last link/node) */
-	addLinkAfter(deque, deque->sentinel->prev, value);
+	/* a full bounded deque reuses its front link as the new back */
+	if (deque->size == deque->capacity && deque->nodes != 0)
+	{
+		struct Link* front = forward(deque, deque->sentinel);
+		if (deque->cursor == front)
+		{
+			deque->cursor = forward(deque, front);
+		}
+		front->value = value;
+		if (deque->size > 1)
+		{
+			moveSentinelBefore(deque, forward(deque, front));
+		}
+		return;
+	}
+
+	/* insert a new node/link before the sentinel (after the last link/node, in the deque's direction) */
+	addLinkAfter(deque, deque->reversed ? deque->sentinel : deque->sentinel->prev, value);
 }
 
 /* FIXME: You will write this function */
@@ -249,7 +474,7 @@ TYPE circularListFront(struct CircularList* deque)
 	assert(deque != 0);
 	assert(deque->size > 0);
 
-	return deque->sentinel->next->value;
+	return forward(deque, deque->sentinel)->value;
 }
 
 /* FIXME: You will write this function */
@@ -267,7 +492,7 @@ TYPE circularListBack(struct CircularList* deque)
 	assert(deque != 0);
 	assert(deque->size > 0);
 
-	return deque->sentinel->prev->value;
+	return backward(deque, deque->sentinel)->value;
 }
 
 /* FIXME: You will write this function */
@@ -285,7 +510,7 @@ void circularListRemoveFront(struct CircularList* deque)
 	assert(deque->size > 0);
 
 	/* remove the first link/node */
-	removeLink(deque, deque->sentinel->next);
+	removeLink(deque, forward(deque, deque->sentinel));
 }
 
 /* FIXME: You will write this function */
@@ -303,7 +528,7 @@ void circularListRemoveBack(struct CircularList* deque)
 	assert(deque->size > 0);
 
 	/* remove the last link/node */
-	removeLink(deque, deque->sentinel->prev);
+	removeLink(deque, backward(deque, deque->sentinel));
 }
 
 /* FIXME: You will write this function */
@@ -358,7 +583,7 @@ void circularListPrint(struct CircularList* deque)
 	else
 	{
 		/* iterate through each of the list's nodes/links & print each value */
-		struct Link* node = deque->sentinel->next;
+		struct Link* node = forward(deque, deque->sentinel);
 
 		printf("Printing the CircularLinkedList's values...\n");
 		printf("CircularLinkedList: ");
@@ -366,10 +591,10 @@ void circularListPrint(struct CircularList* deque)
 		while (node != deque->sentinel)
 		{
 			/* print the node/link's value */
-			printf("%.0f ", node->value);
+			printf(FORMAT_SPECIFIER " ", node->value);
 
 			/* update the node/link that the pointer points to */
-			node = node->next;
+			node = forward(deque, node);
 		}
 
 		/* end the current line of text (from the list of values) */
@@ -377,40 +602,318 @@ void circularListPrint(struct CircularList* deque)
 	}
 }
 
+/**
+	Writes the text of a double as FORMAT_SPECIFIER "%g" would. Whole
+	numbers below 10^6 (which %g prints without an exponent) are
+	formatted directly; anything else falls back to snprintf.
+	param:	p		destination with room for PRINT_VALUE_MAX chars
+	param:	value	double to format
+	ret:	number of chars written (not NUL terminated)
+ */
+static int formatDouble(char* p, double value)
+{
+	if (value > -1e6 && value < 1e6 && value == (double)(long)value && !(value == 0 && signbit(value)))
+	{
+		char digits[8];
+		int n = 0;
+		int len = 0;
+		long v = (long)value;
+
+		if (v < 0)
+		{
+			p[len++] = '-';
+			v = -v;
+		}
+		do
+		{
+			digits[n++] = (char)('0' + v % 10);
+			v /= 10;
+		} while (v != 0);
+		while (n > 0)
+		{
+			p[len++] = digits[--n];
+		}
+		return len;
+	}
+
+	char text[PRINT_VALUE_MAX + 1];
+	int len = snprintf(text, sizeof(text), FORMAT_SPECIFIER, value);
+	if (len > PRINT_VALUE_MAX)
+	{
+		len = PRINT_VALUE_MAX;
+	}
+	memcpy(p, text, (size_t)len);
+	return len;
+}
+
+/**
+	Produces the same text as circularListPrint into the print buffer,
+	formatting each value with FORMAT_VALUE.
+	param:	deque	struct CircularList ptr
+	param:	pb		struct PrintBuffer ptr
+ */
+static void printValues(struct CircularList* deque, struct PrintBuffer* pb)
+{
+	static const char header[] = "Printing the CircularLinkedList's values...\nCircularLinkedList: ";
+	static const char empty[] = "CircularLinkedList is empty...\n";
+
+	if (circularListIsEmpty(deque))
+	{
+		printBufferPut(pb, empty, sizeof(empty) - 1);
+		return;
+	}
+
+	printBufferPut(pb, header, sizeof(header) - 1);
+	for (struct Link* node = forward(deque, deque->sentinel); node != deque->sentinel; node = forward(deque, node))
+	{
+		char text[PRINT_VALUE_MAX + 1];
+		int len = FORMAT_VALUE(text, node->value);
+		text[len++] = ' ';
+		printBufferPut(pb, text, (size_t)len);
+	}
+	printBufferPut(pb, "\n", 1);
+}
+
+/**
+	Prints the deque as circularListPrint does, but to the given FILE,
+	formatting values without printf where possible and writing the
+	text in blocks of PRINT_BUFFER_SIZE chars.
+	param:	deque	struct CircularList ptr
+	param:	out		FILE to write to
+	pre:	deque and out are not null
+	post:	text is written to out
+	ret:	0 on success, -1 if a write to out failed
+ */
+int circularListPrintFile(struct CircularList* deque, FILE* out)
+{
+	assert(deque != 0);
+	assert(out != 0);
+
+	char* data = malloc(PRINT_BUFFER_SIZE);
+	assert(data != 0);
+
+	struct PrintBuffer pb = { out, data, PRINT_BUFFER_SIZE, 0, 0, 0 };
+	printValues(deque, &pb);
+	printBufferFlush(&pb);
+	free(data);
+	return (pb.failed || ferror(out)) ? -1 : 0;
+}
+
+/**
+	Formats the deque as circularListPrint does into a caller's buffer.
+	Like snprintf, the text is truncated to fit and NUL terminated.
+	param:	deque	struct CircularList ptr
+	param:	buffer	destination (may be NULL if size is 0)
+	param:	size	size of buffer in chars
+	pre:	deque is not null
+	ret:	length of the full text, excluding the NUL; the text was
+			truncated if this is >= size
+ */
+size_t circularListPrintBuffer(struct CircularList* deque, char* buffer, size_t size)
+{
+	assert(deque != 0);
+	assert(buffer != 0 || size == 0);
+
+	if (size == 0)
+	{
+		char none;
+		struct PrintBuffer pb = { 0, &none, 0, 0, 0, 0 };
+		printValues(deque, &pb);
+		return pb.total;
+	}
+
+	struct PrintBuffer pb = { 0, buffer, size - 1, 0, 0, 0 };
+	printValues(deque, &pb);
+	buffer[pb.used] = '\0';
+	return pb.total;
+}
+
 /* FIXME: You will write this function */
 /**
-	Reverses the deque in place without allocating any new memory.
-	The process works as follows: current starts pointing to sentinel;
-	tmp points to current's next, current's next points to current's prev,
-	current's prev is assigned to tmp and current points to current's next
-	(which points to current's prev), so you proceed stepping back through 
-	the deque, assigning current's next to current's prev, until current 
-	points to the sentinel then you know the each link has been looked at
-	and the link order reversed.
+	Reverses the deque in O(1), without touching any link: flipping
+	the deque's direction bit makes every operation read next and
+	prev swapped, so the old back is the new front.
 	param: 	deque 	struct CircularList ptr
 	pre:	deque is not null
-	pre:	deque is not empty
-	post:	order of deque links is reversed
+	post:	order of deque values is reversed
  */
 void circularListReverse(struct CircularList* deque)
 {
-	/* assert to validate the deque is not NULL & is not empty */
+	/* assert to validate the deque is not NULL */
+	assert(deque != 0);
+
+	deque->reversed = !deque->reversed;
+}
+
+/**
+	Returns the link the deque's cursor is on: the front link if the
+	cursor is on the sentinel. Does not move the cursor.
+	param: 	deque 	struct CircularList ptr
+	ret:	link at the cursor; the sentinel only if the deque is empty
+ */
+static struct Link* cursorLink(struct CircularList* deque)
+{
+	if (deque->cursor == deque->sentinel)
+	{
+		return forward(deque, deque->sentinel);
+	}
+	return deque->cursor;
+}
+
+/**
+	Returns the value at the deque's cursor. A deque's cursor starts
+	at the front, and circularListNext moves it to the following
+	value.
+	param: 	deque 	struct CircularList ptr
+	pre:	deque is not null
+	pre:	deque is not empty
+	ret:	value of the link at the cursor
+ */
+TYPE circularListCursor(struct CircularList* deque)
+{
 	assert(deque != 0);
 	assert(deque->size > 0);
 
-	/* create the "current" and "tmp" (temp) pointers */
-	struct Link* current = deque->sentinel;
-	struct Link* tmp = current->next;
+	return cursorLink(deque)->value;
+}
 
-	/* iterate through the list's nodes/links */
-	do
+/**
+	Advances the cursor to the next link in the deque's direction,
+	wrapping from the back to the front, and returns its value.
+	O(1); allocates nothing.
+	param: 	deque 	struct CircularList ptr
+	pre:	deque is not null
+	pre:	deque is not empty
+	post:	cursor is on the following link (the front after the back)
+	ret:	value of the link now at the cursor
+ */
+TYPE circularListNext(struct CircularList* deque)
+{
+	assert(deque != 0);
+	assert(deque->size > 0);
+
+	/* step over the sentinel when wrapping around */
+	struct Link* link = forward(deque, cursorLink(deque));
+	if (link == deque->sentinel)
 	{
-		/* update pointers */
-		current->next = current->prev;
-		current->prev = tmp;
-		tmp = current;
-
-		/* point "current" to the next node/link */
-		current = current->next;
-	} while (current != deque->sentinel);
+		link = forward(deque, link);
+	}
+	deque->cursor = link;
+	return link->value;
+}
+
+/**
+	Removes the link at the cursor. The cursor moves on to the
+	following link, wrapping to the front if the back was removed.
+	param: 	deque 	struct CircularList ptr
+	pre:	deque is not null
+	pre:	deque is not empty
+	post:	link at the cursor is removed and freed (call to removeLink)
+ */
+void circularListRemoveAtCursor(struct CircularList* deque)
+{
+	assert(deque != 0);
+	assert(deque->size > 0);
+
+	removeLink(deque, cursorLink(deque));
+}
+
+/**
+	Inserts a new link with the given value just before the cursor
+	(in the deque's direction), so the cursor reaches it only after
+	a full lap. A cursor standing for the front stays on that link,
+	and the new value becomes the front.
+	param: 	deque 	struct CircularList ptr
+	param: 	value 	TYPE
+	pre:	deque is not null
+	post:	new link is before the cursor, which has not moved
+			(unless it was on the front of a full bounded deque,
+			whose front is removed first to make room, moving the
+			cursor on to the following value)
+ */
+void circularListInsertAtCursor(struct CircularList* deque, TYPE value)
+{
+	assert(deque != 0);
+
+	if (deque->size == deque->capacity && deque->nodes != 0)
+	{
+		removeLink(deque, forward(deque, deque->sentinel));
+	}
+
+	/* pin a cursor standing for the front, so the new front does not take it */
+	struct Link* cursor = cursorLink(deque);
+	deque->cursor = cursor;
+	addLinkAfter(deque, deque->reversed ? cursor : cursor->prev, value);
+}
+
+/**
+	Rotates the deque k places toward the front: the value k places
+	from the front becomes the front and the values before it move,
+	in order, to the back (negative k rotates the other way). Only
+	the sentinel is relinked, after walking min(k, size - k) links
+	from whichever end is closer. The cursor stays on its link.
+	param: 	deque 	struct CircularList ptr
+	param: 	k 		places to rotate by, taken modulo the size
+	pre:	deque is not null
+	post:	deque front is the value that was k places from it
+ */
+void circularListRotate(struct CircularList* deque, int k)
+{
+	assert(deque != 0);
+
+	if (deque->size == 0)
+	{
+		return;
+	}
+	k %= deque->size;
+	if (k < 0)
+	{
+		k += deque->size;
+	}
+	if (k == 0)
+	{
+		return;
+	}
+
+	/* find the new front from the closer end */
+	struct Link* sentinel = deque->sentinel;
+	struct Link* front;
+	if (k <= deque->size - k)
+	{
+		front = forward(deque, sentinel);
+		for (int i = 0; i < k; i++)
+			front = forward(deque, front);
+	}
+	else
+	{
+		front = sentinel;
+		for (int i = 0; i < deque->size - k; i++)
+			front = backward(deque, front);
+	}
+
+	moveSentinelBefore(deque, front);
+}
+
+/**
+	Copies up to n values out of the deque, front to back: for a
+	bounded deque filled at the back, its window of samples oldest
+	first.
+	param: 	deque 	struct CircularList ptr
+	param: 	out 	buffer for n values
+	param: 	n 		most values to copy
+	pre:	deque is not null
+	pre:	out is not null or n is 0
+	ret:	number of values copied, min(n, size)
+ */
+int circularListExport(struct CircularList* deque, TYPE* out, int n)
+{
+	assert(deque != 0);
+	assert(out != 0 || n == 0);
+
+	int count = 0;
+	for (struct Link* node = forward(deque, deque->sentinel); node != deque->sentinel && count < n; node = forward(deque, node))
+	{
+		out[count++] = node->value;
+	}
+	return count;
 }
@@ -1,6 +1,9 @@
 #ifndef CIRCULAR_LIST_H
 #define CIRCULAR_LIST_H
 
+#include <stdio.h>
+#include "../allocator.h"
+
 #ifndef TYPE
 #define TYPE double
 #endif
@@ -16,9 +19,13 @@
 struct CircularList;
 
 struct CircularList* circularListCreate();
+struct CircularList* circularListCreateWithAllocator(const struct Allocator* allocator);
+struct CircularList* circularListCreateBounded(int capacity, const struct Allocator* allocator);
 void circularListDestroy(struct CircularList* list);
 void circularListPrint(struct CircularList* list);
 void circularListReverse(struct CircularList* list);
+int circularListPrintFile(struct CircularList* list, FILE* out);
+size_t circularListPrintBuffer(struct CircularList* list, char* buffer, size_t size);
 
 // Deque interface
 
@@ -30,4 +37,16 @@ void circularListRemoveFront(struct CircularList* list);
 void circularListRemoveBack(struct CircularList* list);
 int circularListIsEmpty(struct CircularList* list);
 
+// Cursor interface
+
+TYPE circularListCursor(struct CircularList* list);
+TYPE circularListNext(struct CircularList* list);
+void circularListRemoveAtCursor(struct CircularList* list);
+void circularListInsertAtCursor(struct CircularList* list, TYPE value);
+void circularListRotate(struct CircularList* list, int k);
+
+// Bulk interface
+
+int circularListExport(struct CircularList* list, TYPE* out, int n);
+
 #endif
\ No newline at end of file
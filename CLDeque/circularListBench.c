@@ -0,0 +1,332 @@
+/***********************************************************
+* Filename: circularListBench.c
+*
+* Overview:
+*   Micro-benchmarks for the circular list deque. Each
+*	benchmark is selected by name on the command line; with
+*	no arguments every benchmark is run.
+*		- print: time to print 10^6 values to /dev/null with
+*		  circularListPrint vs circularListPrintFile
+*		- alloc: build and tear down a 10^5 value deque per
+*		  request, with malloc vs an arena reset per request
+*		- reverse: ns per circularListReverse, and per value of a
+*		  front-to-back drain after it, on 10^3 .. 10^6 values
+*		- roundrobin: ns per step around a ring of 10^3 and 10^6
+*		  values with Front + RemoveFront + AddBack, with
+*		  circularListNext and with circularListRotate(list, 1)
+*		- window: ns per sample keeping the last 10^3 / 10^5 of
+*		  10^7 samples with AddBack + RemoveFront vs a bounded
+*		  deque's overwriting AddBack, and ns per value exported
+*		- traverse: ns and dTLB load misses per link of
+*		  circularListPrintFile and circularListDestroy over
+*		  4 * 10^6 links whose ring order is scattered through
+*		  memory, with one malloc per link, an arena and a
+*		  huge-page arena; the misses are shown as n/a where
+*		  perf events are unavailable (perfCounter.h)
+*
+* Usage:
+*	1) make -f makefilecirListDeque bench
+*	2) ./bench [print|alloc|reverse|roundrobin|window|traverse]
+************************************************************/
+#define _POSIX_C_SOURCE 199309L
+#define _DEFAULT_SOURCE		// mmap huge page flags (allocator.h), syscall (perfCounter.h)
+#include "circularList.h"
+#include "../perfCounter.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+/**
+	Returns a monotonic timestamp in nanoseconds.
+ */
+static double nowNs()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+/**
+	Prints a deque of 10^6 values to /dev/null through stdout with
+	circularListPrint and through a FILE with circularListPrintFile.
+ */
+static void benchPrint()
+{
+	long n = 1000000;
+	struct CircularList* deque = circularListCreate();
+	for (long i = 0; i < n; i++)
+		circularListAddBack(deque, (TYPE)i);
+
+	FILE* devNull = fopen("/dev/null", "w");
+
+	/* point stdout at /dev/null while circularListPrint runs */
+	fflush(stdout);
+	int savedStdout = dup(STDOUT_FILENO);
+	dup2(fileno(devNull), STDOUT_FILENO);
+
+	double start = nowNs();
+	circularListPrint(deque);
+	fflush(stdout);
+	double printfNs = nowNs() - start;
+
+	dup2(savedStdout, STDOUT_FILENO);
+	close(savedStdout);
+
+	start = nowNs();
+	circularListPrintFile(deque, devNull);
+	fflush(devNull);
+	double bufferedNs = nowNs() - start;
+
+	printf("%-22s %10s\n", "print 10^6 values", "ns/value");
+	printf("%-22s %10.1f\n", "circularListPrint", printfNs / n);
+	printf("%-22s %10.1f\n", "circularListPrintFile", bufferedNs / n);
+
+	fclose(devNull);
+	circularListDestroy(deque);
+}
+
+/**
+	Builds a deque of 10^5 values and throws it away, 100 times over:
+	with malloc (circularListDestroy frees each link) and with an arena
+	(the deque is abandoned and the arena reset, freeing it in one shot).
+ */
+static void benchAlloc()
+{
+	long n = 100000;
+	int requests = 100;
+
+	double start = nowNs();
+	for (int r = 0; r < requests; r++)
+	{
+		struct CircularList* deque = circularListCreate();
+		for (long i = 0; i < n; i++)
+			circularListAddBack(deque, (TYPE)i);
+		circularListDestroy(deque);
+	}
+	double mallocNs = nowNs() - start;
+
+	struct Arena* arena = arenaCreate(0);
+	struct Allocator allocator = arenaAllocator(arena);
+	start = nowNs();
+	for (int r = 0; r < requests; r++)
+	{
+		struct CircularList* deque = circularListCreateWithAllocator(&allocator);
+		for (long i = 0; i < n; i++)
+			circularListAddBack(deque, (TYPE)i);
+		arenaReset(arena);
+	}
+	double arenaNs = nowNs() - start;
+	arenaDestroy(arena);
+
+	printf("%-22s %10s\n", "10^5 values/request", "ns/value");
+	printf("%-22s %10.1f\n", "malloc + destroy", mallocNs / ((double)n * requests));
+	printf("%-22s %10.1f\n", "arena + reset", arenaNs / ((double)n * requests));
+}
+
+/**
+	Reverses deques of 10^3 .. 10^6 values 1001 times each (ending up
+	reversed), then drains each from the front, reporting ns per
+	reverse (which should stay flat) and per removal.
+ */
+static void benchReverse()
+{
+	printf("%-10s %14s %14s\n", "n", "reverse ns", "drain ns/value");
+	for (long n = 1000; n <= 1000000; n *= 10)
+	{
+		struct CircularList* deque = circularListCreate();
+		for (long i = 0; i < n; i++)
+			circularListAddBack(deque, (TYPE)i);
+
+		int reps = 1001;
+		double start = nowNs();
+		for (int r = 0; r < reps; r++)
+			circularListReverse(deque);
+		double reverseNs = (nowNs() - start) / reps;
+
+		if (circularListFront(deque) != (TYPE)(n - 1))
+			printf("unexpected front\n");
+		start = nowNs();
+		while (!circularListIsEmpty(deque))
+			circularListRemoveFront(deque);
+		double drainNs = (nowNs() - start) / n;
+
+		printf("%-10ld %14.1f %14.1f\n", n, reverseNs, drainNs);
+		circularListDestroy(deque);
+	}
+}
+
+/**
+	Steps 10^7 times around rings of 10^3 and 10^6 values, summing
+	the values visited: by popping the front and pushing it to the
+	back, by advancing the cursor, and by rotating one place.
+ */
+static void benchRoundRobin()
+{
+	long steps = 10000000;
+	printf("%-10s %14s %14s %14s\n", "n", "pop+push ns", "next ns", "rotate ns");
+	for (long n = 1000; n <= 1000000; n *= 1000)
+	{
+		struct CircularList* deque = circularListCreate();
+		for (long i = 0; i < n; i++)
+			circularListAddBack(deque, (TYPE)i);
+		double sums[3] = { 0, 0, 0 };
+
+		double start = nowNs();
+		for (long i = 0; i < steps; i++)
+		{
+			TYPE value = circularListFront(deque);
+			circularListRemoveFront(deque);
+			circularListAddBack(deque, value);
+			sums[0] += value;
+		}
+		double popNs = (nowNs() - start) / steps;
+
+		start = nowNs();
+		for (long i = 0; i < steps; i++)
+			sums[1] += circularListNext(deque);
+		double nextNs = (nowNs() - start) / steps;
+
+		start = nowNs();
+		for (long i = 0; i < steps; i++)
+		{
+			sums[2] += circularListFront(deque);
+			circularListRotate(deque, 1);
+		}
+		double rotateNs = (nowNs() - start) / steps;
+
+		if (sums[0] != sums[1] || sums[1] != sums[2])
+			printf("visited different values\n");
+		printf("%-10ld %14.1f %14.1f %14.1f\n", n, popNs, nextNs, rotateNs);
+		circularListDestroy(deque);
+	}
+}
+
+/**
+	Feeds 10^7 samples into a window of the last 10^3 and 10^5: with
+	an unbounded deque trimmed by RemoveFront, and with a bounded
+	deque whose AddBack overwrites the oldest sample. Then exports
+	the bounded window, oldest first.
+ */
+static void benchWindow()
+{
+	long samples = 10000000;
+	printf("%-10s %14s %14s %14s\n", "window", "trim ns", "bounded ns", "export ns");
+	for (int window = 1000; window <= 100000; window *= 100)
+	{
+		struct CircularList* deque = circularListCreate();
+		int size = 0;
+		double start = nowNs();
+		for (long i = 0; i < samples; i++)
+		{
+			circularListAddBack(deque, (TYPE)i);
+			if (size == window)
+				circularListRemoveFront(deque);
+			else
+				size++;
+		}
+		double trimNs = (nowNs() - start) / samples;
+		circularListDestroy(deque);
+
+		deque = circularListCreateBounded(window, 0);
+		start = nowNs();
+		for (long i = 0; i < samples; i++)
+			circularListAddBack(deque, (TYPE)i);
+		double boundedNs = (nowNs() - start) / samples;
+
+		TYPE* values = malloc((size_t)window * sizeof(TYPE));
+		start = nowNs();
+		int count = circularListExport(deque, values, window);
+		double exportNs = (nowNs() - start) / window;
+		if (count != window || values[0] != (TYPE)(samples - window))
+			printf("unexpected window\n");
+		free(values);
+		circularListDestroy(deque);
+
+		printf("%-10d %14.1f %14.1f %14.1f\n", window, trimNs, boundedNs, exportNs);
+	}
+}
+
+/**
+	Builds a ring of 4 * 10^6 links by inserting each value a few
+	random steps of the cursor past the last one, so that neighbors in
+	the ring were allocated far apart, then prints it with
+	circularListPrintFile and frees it with circularListDestroy. Runs
+	with malloc (one call per link), an arena and a huge-page arena,
+	reporting ns and dTLB load misses per link.
+ */
+static void benchTraverse()
+{
+	static const char* const pageKinds[] = { "normal", "transparent", "hugetlb" };
+	long n = 4000000;
+	int fd = dtlbCounterOpen();
+	FILE* devNull = fopen("/dev/null", "w");
+
+	printf("%-8s %-12s %12s %12s %12s %12s\n", "links", "pages", "print ns", "print dTLB", "destroy ns", "destroy dTLB");
+	for (int mode = 0; mode < 3; mode++)
+	{
+		struct Arena* arena = (mode == 0) ? 0 : (mode == 1) ? arenaCreate(0) : arenaCreateHuge(0);
+		struct Allocator allocator = (arena != 0) ? arenaAllocator(arena) : allocatorMalloc();
+		struct CircularList* deque = circularListCreateWithAllocator(&allocator);
+
+		unsigned int x = 2463534242u;
+		circularListAddBack(deque, (TYPE)0);
+		for (long i = 1; i < n; i++)
+		{
+			x ^= x << 13;
+			x ^= x >> 17;
+			x ^= x << 5;
+			for (unsigned int steps = x % 8; steps > 0; steps--)
+				circularListNext(deque);
+			circularListInsertAtCursor(deque, (TYPE)i);
+		}
+
+		counterStart(fd);
+		double start = nowNs();
+		circularListPrintFile(deque, devNull);
+		fflush(devNull);
+		double printNs = nowNs() - start;
+		long long printMisses = counterStop(fd);
+
+		counterStart(fd);
+		start = nowNs();
+		circularListDestroy(deque);
+		double destroyNs = nowNs() - start;
+		long long destroyMisses = counterStop(fd);
+
+		char printText[32], destroyText[32];
+		printf("%-8s %-12s %12.1f %12s %12.1f %12s\n",
+			(mode == 0) ? "malloc" : (mode == 1) ? "arena" : "huge",
+			pageKinds[(arena != 0) ? arenaPageKind(arena) : 0],
+			printNs / n, perValue(printText, sizeof(printText), printMisses, n),
+			destroyNs / n, perValue(destroyText, sizeof(destroyText), destroyMisses, n));
+
+		if (arena != 0)
+			arenaDestroy(arena);
+	}
+
+	fclose(devNull);
+	if (fd >= 0)
+		close(fd);
+}
+
+int main(int argc, char** argv)
+{
+	int all = (argc < 2);
+
+	if (all || strcmp(argv[1], "print") == 0)
+		benchPrint();
+	if (all || strcmp(argv[1], "alloc") == 0)
+		benchAlloc();
+	if (all || strcmp(argv[1], "reverse") == 0)
+		benchReverse();
+	if (all || strcmp(argv[1], "roundrobin") == 0)
+		benchRoundRobin();
+	if (all || strcmp(argv[1], "window") == 0)
+		benchWindow();
+	if (all || strcmp(argv[1], "traverse") == 0)
+		benchTraverse();
+
+	return 0;
+}
@@ -0,0 +1,478 @@
+/***********************************************************
+* Filename: circularListTest.c
+*
+* Overview:
+*   Randomized tests of circularList.c against an array model
+*	of the deque. Each test applies a long random sequence of
+*	operations to a deque and to the model and asserts after
+*	every step that the two agree; main runs them all. Build
+*	and run with
+*		make -f makefilecirListDeque test
+*	(the target builds with -fsanitize=address,undefined, so
+*	use-after-free and leaks fail the run as well).
+*
+*	- reverse: adds, removes and O(1) reversals, with the
+*	  buffered print checked against the model's values
+*	- cursor: the cursor functions and rotations mixed with
+*	  the deque operations; the cursor reads as the front
+*	  until it is moved, and after the link it was on is
+*	  removed from the back
+*	- bounded: the same mix on a bounded deque, where adds to
+*	  a full deque overwrite the other end and a cursor on the
+*	  overwritten value moves on as if it had been removed;
+*	  circularListExport is checked against the model
+************************************************************/
+#include "circularList.h"
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* most values a model holds */
+#define MODEL_CAPACITY 4096
+
+// Array model of a deque: values[0] is the front
+struct Model
+{
+	TYPE values[MODEL_CAPACITY];
+	int size;
+	int cursor;		// index of the cursor's value; -1 while it stands for the front
+};
+
+static void modelInsert(struct Model* model, int at, TYPE value)
+{
+	assert(model->size < MODEL_CAPACITY);
+	memmove(model->values + at + 1, model->values + at, (size_t)(model->size - at) * sizeof(TYPE));
+	model->values[at] = value;
+	model->size++;
+}
+
+static void modelDelete(struct Model* model, int at)
+{
+	memmove(model->values + at, model->values + at + 1, (size_t)(model->size - at - 1) * sizeof(TYPE));
+	model->size--;
+}
+
+static void modelReverse(struct Model* model)
+{
+	for (int i = 0, j = model->size - 1; i < j; i++, j--)
+	{
+		TYPE value = model->values[i];
+		model->values[i] = model->values[j];
+		model->values[j] = value;
+	}
+}
+
+static void modelRotate(struct Model* model, int k)
+{
+	static TYPE rotated[MODEL_CAPACITY];
+	int n = model->size;
+	k = ((k % n) + n) % n;
+	for (int i = 0; i < n; i++)
+	{
+		rotated[i] = model->values[(i + k) % n];
+	}
+	memcpy(model->values, rotated, (size_t)n * sizeof(TYPE));
+	if (model->cursor >= 0)
+	{
+		model->cursor = (model->cursor - k + n) % n;
+	}
+}
+
+/* index of the value at the model's cursor */
+static int modelCursor(struct Model* model)
+{
+	return model->cursor >= 0 ? model->cursor : 0;
+}
+
+/* the model after its front value is removed */
+static void modelRemoveFront(struct Model* model)
+{
+	modelDelete(model, 0);
+	if (model->cursor > 0)
+	{
+		model->cursor--;
+	}
+	else if (model->cursor == 0 && model->size == 0)
+	{
+		model->cursor = -1;
+	}
+}
+
+/* the model after its back value is removed: a cursor on it wraps to the front */
+static void modelRemoveBack(struct Model* model)
+{
+	modelDelete(model, model->size - 1);
+	if (model->cursor == model->size)
+	{
+		model->cursor = -1;
+	}
+}
+
+/**
+	Asserts that the deque's size, front and back match the model.
+ */
+static void assertEnds(struct CircularList* deque, struct Model* model)
+{
+	assert(circularListIsEmpty(deque) == (model->size == 0));
+	if (model->size > 0)
+	{
+		assert(circularListFront(deque) == model->values[0]);
+		assert(circularListBack(deque) == model->values[model->size - 1]);
+	}
+}
+
+/**
+	Asserts that circularListPrintBuffer writes the model's values.
+ */
+static void assertPrinted(struct CircularList* deque, struct Model* model)
+{
+	static char printed[1 << 17];
+	static char expected[1 << 17];
+	size_t length;
+
+	if (model->size == 0)
+	{
+		length = (size_t)sprintf(expected, "CircularLinkedList is empty...\n");
+	}
+	else
+	{
+		length = (size_t)sprintf(expected, "Printing the CircularLinkedList's values...\nCircularLinkedList: ");
+		for (int i = 0; i < model->size; i++)
+		{
+			length += (size_t)sprintf(expected + length, "%g ", (double)model->values[i]);
+		}
+		length += (size_t)sprintf(expected + length, "\n");
+	}
+	assert(circularListPrintBuffer(deque, printed, sizeof(printed)) == length);
+	assert(memcmp(printed, expected, length) == 0);
+}
+
+/**
+	Adds and removes at both ends, reversing the deque now and then,
+	and checks the ends after every step and the printed values
+	every so often.
+ */
+static void testReverse()
+{
+	static struct Model model;
+	struct CircularList* deque = circularListCreate();
+	model.size = 0;
+	srand(3);
+
+	for (int step = 0; step < 200000; step++)
+	{
+		int op = rand() % 7;
+		if (model.size > 2000)
+		{
+			op = 3 + rand() % 2;
+		}
+		switch (op)
+		{
+		case 0:
+		case 5:
+			circularListAddFront(deque, (TYPE)step);
+			modelInsert(&model, 0, (TYPE)step);
+			break;
+		case 1:
+		case 6:
+			circularListAddBack(deque, (TYPE)step);
+			modelInsert(&model, model.size, (TYPE)step);
+			break;
+		case 2:
+			circularListReverse(deque);
+			modelReverse(&model);
+			break;
+		case 3:
+			if (model.size > 0)
+			{
+				circularListRemoveFront(deque);
+				modelDelete(&model, 0);
+			}
+			break;
+		default:
+			if (model.size > 0)
+			{
+				circularListRemoveBack(deque);
+				modelDelete(&model, model.size - 1);
+			}
+			break;
+		}
+
+		assertEnds(deque, &model);
+		if (step % 997 == 0)
+		{
+			assertPrinted(deque, &model);
+		}
+	}
+	circularListDestroy(deque);
+}
+
+/**
+	Moves, reads, removes and inserts at the cursor between adds,
+	removes, reversals and rotations, and checks the value at the
+	cursor against the model after every step.
+ */
+static void testCursor()
+{
+	static struct Model model;
+	struct CircularList* deque = circularListCreate();
+	model.size = 0;
+	model.cursor = -1;
+	srand(11);
+
+	/* Next always moves off the value Cursor reads: the front of a
+	   new deque, and again once the cursor's back link is removed */
+	circularListAddBack(deque, (TYPE)1);
+	circularListAddBack(deque, (TYPE)2);
+	circularListAddBack(deque, (TYPE)3);
+	assert(circularListNext(deque) == (TYPE)2);
+	assert(circularListNext(deque) == (TYPE)3);
+	circularListRemoveBack(deque);
+	assert(circularListCursor(deque) == (TYPE)1);
+	assert(circularListNext(deque) == (TYPE)2);
+	circularListRemoveFront(deque);
+	circularListRemoveFront(deque);
+	assert(circularListIsEmpty(deque));
+
+	for (int step = 0; step < 400000; step++)
+	{
+		int op = rand() % 12;
+		if (model.size > 1500 && (op == 0 || op == 1 || op == 8))
+		{
+			op = 2;
+		}
+		switch (op)
+		{
+		case 0:
+			circularListAddFront(deque, (TYPE)step);
+			modelInsert(&model, 0, (TYPE)step);
+			if (model.cursor >= 0)
+			{
+				model.cursor++;
+			}
+			break;
+		case 1:
+			circularListAddBack(deque, (TYPE)step);
+			modelInsert(&model, model.size, (TYPE)step);
+			break;
+		case 2:
+			if (model.size > 0)
+			{
+				circularListRemoveFront(deque);
+				modelRemoveFront(&model);
+			}
+			break;
+		case 3:
+			if (model.size > 0)
+			{
+				circularListRemoveBack(deque);
+				modelRemoveBack(&model);
+			}
+			break;
+		case 4:
+			circularListReverse(deque);
+			modelReverse(&model);
+			if (model.cursor >= 0)
+			{
+				model.cursor = model.size - 1 - model.cursor;
+			}
+			break;
+		case 5:
+		case 6:
+			if (model.size > 0)
+			{
+				model.cursor = (modelCursor(&model) + 1) % model.size;
+				assert(circularListNext(deque) == model.values[model.cursor]);
+			}
+			break;
+		case 7:
+			if (model.size > 0)
+			{
+				assert(circularListCursor(deque) == model.values[modelCursor(&model)]);
+			}
+			break;
+		case 8:
+			circularListInsertAtCursor(deque, (TYPE)-step);
+			if (model.size > 0)
+			{
+				model.cursor = modelCursor(&model);
+				modelInsert(&model, model.cursor++, (TYPE)-step);
+			}
+			else
+			{
+				modelInsert(&model, 0, (TYPE)-step);
+			}
+			break;
+		case 9:
+			if (model.size > 0)
+			{
+				int at = modelCursor(&model);
+				circularListRemoveAtCursor(deque);
+				modelDelete(&model, at);
+				if (model.cursor >= 0 && model.cursor == model.size)
+				{
+					model.cursor = -1;
+				}
+			}
+			break;
+		default:
+			if (model.size > 0)
+			{
+				int k = rand() % (2 * model.size + 1) - model.size;
+				circularListRotate(deque, k);
+				modelRotate(&model, k);
+			}
+			break;
+		}
+
+		assertEnds(deque, &model);
+		if (model.size > 0)
+		{
+			assert(circularListCursor(deque) == model.values[modelCursor(&model)]);
+		}
+	}
+	circularListDestroy(deque);
+}
+
+/**
+	Runs the cursor test's operations on a bounded deque of the given
+	capacity, made with malloc or an arena, so that adds often find it
+	full, and checks circularListExport against the model.
+ */
+static void testBounded(int capacity, int useArena)
+{
+	static struct Model model;
+	struct Arena* arena = arenaCreate(0);
+	struct Allocator allocator = arenaAllocator(arena);
+	struct CircularList* deque = circularListCreateBounded(capacity, useArena ? &allocator : 0);
+	model.size = 0;
+	model.cursor = -1;
+	srand(5);
+
+	for (int step = 0; step < 400000; step++)
+	{
+		int full = (model.size == capacity);
+		switch (rand() % 14)
+		{
+		case 0:
+			/* a full deque's back value becomes the front; a cursor on it wraps */
+			circularListAddFront(deque, (TYPE)step);
+			if (full)
+			{
+				modelRemoveBack(&model);
+			}
+			modelInsert(&model, 0, (TYPE)step);
+			if (model.cursor >= 0)
+			{
+				model.cursor++;
+			}
+			break;
+		case 1:
+		case 12:
+		case 13:
+			/* a full deque's front value becomes the back; a cursor on it moves on */
+			circularListAddBack(deque, (TYPE)step);
+			if (full)
+			{
+				modelRemoveFront(&model);
+			}
+			modelInsert(&model, model.size, (TYPE)step);
+			break;
+		case 2:
+			if (model.size > 0)
+			{
+				circularListRemoveFront(deque);
+				modelRemoveFront(&model);
+			}
+			break;
+		case 3:
+			if (model.size > 0)
+			{
+				circularListRemoveBack(deque);
+				modelRemoveBack(&model);
+			}
+			break;
+		case 4:
+			circularListReverse(deque);
+			modelReverse(&model);
+			if (model.cursor >= 0)
+			{
+				model.cursor = model.size - 1 - model.cursor;
+			}
+			break;
+		case 5:
+			if (model.size > 0)
+			{
+				model.cursor = (modelCursor(&model) + 1) % model.size;
+				assert(circularListNext(deque) == model.values[model.cursor]);
+			}
+			break;
+		case 6:
+			if (model.size > 0)
+			{
+				int at = modelCursor(&model);
+				circularListRemoveAtCursor(deque);
+				modelDelete(&model, at);
+				if (model.cursor >= 0 && model.cursor == model.size)
+				{
+					model.cursor = -1;
+				}
+			}
+			break;
+		case 7:
+			circularListInsertAtCursor(deque, (TYPE)-step);
+			if (full)
+			{
+				modelRemoveFront(&model);
+			}
+			if (model.size > 0)
+			{
+				model.cursor = modelCursor(&model);
+				modelInsert(&model, model.cursor++, (TYPE)-step);
+			}
+			else
+			{
+				modelInsert(&model, 0, (TYPE)-step);
+			}
+			break;
+		case 8:
+			if (model.size > 0)
+			{
+				int k = rand() % (2 * model.size + 1) - model.size;
+				circularListRotate(deque, k);
+				modelRotate(&model, k);
+			}
+			break;
+		default:
+		{
+			static TYPE exported[MODEL_CAPACITY];
+			int n = rand() % (capacity + 2);
+			int count = circularListExport(deque, exported, n);
+			assert(count == (n < model.size ? n : model.size));
+			assert(memcmp(exported, model.values, (size_t)count * sizeof(TYPE)) == 0);
+			break;
+		}
+		}
+
+		assert(model.size <= capacity);
+		assertEnds(deque, &model);
+		if (model.size > 0)
+		{
+			assert(circularListCursor(deque) == model.values[modelCursor(&model)]);
+		}
+	}
+	circularListDestroy(deque);
+	arenaDestroy(arena);
+}
+
+int main()
+{
+	testReverse();
+	testCursor();
+	testBounded(1, 0);
+	testBounded(37, 0);
+	testBounded(37, 1);
+	printf("all tests passed\n");
+	return 0;
+}
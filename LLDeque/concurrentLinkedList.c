@@ -0,0 +1,288 @@
+/***********************************************************
+* Filename: concurrentLinkedList.c
+*
+* Overview:
+*   This program is a thread-safe linked list deque that any
+*	number of producer and consumer threads may share. It uses
+*	the same design as linkedList.c (double links between a
+*	front and a back sentinel) and guards each end with its own
+*	mutex, so operations at the front and at the back proceed
+*	in parallel instead of queueing on one global lock.
+*
+*	The two ends only touch the same links when the deque is
+*	nearly empty. To keep them apart, count holds the number of
+*	links that no thread has claimed for removal:
+*		- a remove claims a link by atomically decrementing count,
+*		  which it only does while at least 3 are unclaimed, so
+*		  the links it touches (the end link and its neighbor's
+*		  pointer facing it) are never touched by the other end
+*		- an add only holds its end's lock while count >= 2, and
+*		  increments count after the new link is in place
+*	Anything else (a nearly empty deque) takes the slow path:
+*	both locks, always in front-then-back order.
+************************************************************/
+#include "concurrentLinkedList.h"
+#include <assert.h>
+#include <stdlib.h>
+#include <pthread.h>
+
+/* keeps the two end locks on separate cache lines */
+#define CACHE_LINE 64
+
+// Double link
+struct Link
+{
+	TYPE value;
+	struct Link* next;
+	struct Link* prev;
+};
+
+// Double linked list with front and back sentinels, locked per end
+struct ConcurrentLinkedList
+{
+	pthread_mutex_t frontLock;
+	char frontPad[CACHE_LINE];
+	pthread_mutex_t backLock;
+	char backPad[CACHE_LINE];
+	int count;		// unclaimed links; accessed atomically
+	struct Link frontSentinel;
+	struct Link backSentinel;
+};
+
+/**
+	Atomically decrements count if at least min links are unclaimed.
+	param: 	list 	struct ConcurrentLinkedList ptr
+	param:	min		smallest count that may be claimed from
+	ret:	1 if a link was claimed, 0 otherwise
+ */
+static int claimLink(struct ConcurrentLinkedList* list, int min)
+{
+	int count = __atomic_load_n(&list->count, __ATOMIC_SEQ_CST);
+	while (count >= min)
+	{
+		if (__atomic_compare_exchange_n(&list->count, &count, count - 1, 0,
+			__ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST))
+		{
+			return 1;
+		}
+	}
+	return 0;
+}
+
+/**
+	Links a new link with the given value in before the given link.
+	param: 	link 	struct Link ptr
+ 	param: 	value 	TYPE
+	pre:	caller holds the lock(s) covering link and link->prev
+ */
+static void addLinkBefore(struct Link* link, TYPE value)
+{
+	struct Link* node = malloc(sizeof(struct Link));
+	assert(node != 0);
+
+	node->value = value;
+	node->next = link;
+	node->prev = link->prev;
+	link->prev->next = node;
+	link->prev = node;
+}
+
+/**
+	Unlinks the given link, returning its value and freeing it.
+	param: 	link 	struct Link ptr
+	pre:	caller holds the lock(s) covering link and its neighbors
+	ret:	the removed link's value
+ */
+static TYPE removeLink(struct Link* link)
+{
+	TYPE value = link->value;
+
+	link->prev->next = link->next;
+	link->next->prev = link->prev;
+	free(link);
+	return value;
+}
+
+/**
+	Allocates and initializes an empty deque.
+	pre: 	none
+	post: 	memory allocated for new struct ConcurrentLinkedList ptr
+	return: list
+ */
+struct ConcurrentLinkedList* concurrentListCreate()
+{
+	struct ConcurrentLinkedList* list = malloc(sizeof(struct ConcurrentLinkedList));
+	assert(list != 0);
+
+	pthread_mutex_init(&list->frontLock, NULL);
+	pthread_mutex_init(&list->backLock, NULL);
+	list->count = 0;
+	list->frontSentinel.next = &list->backSentinel;
+	list->frontSentinel.prev = NULL;
+	list->backSentinel.prev = &list->frontSentinel;
+	list->backSentinel.next = NULL;
+	return list;
+}
+
+/**
+	Deallocates every link in the deque and the deque itself.
+	param:	list 	struct ConcurrentLinkedList ptr
+	pre: 	list is not null
+	pre:	no other thread is using the list
+ */
+void concurrentListDestroy(struct ConcurrentLinkedList* list)
+{
+	assert(list != 0);
+
+	struct Link* link = list->frontSentinel.next;
+	while (link != &list->backSentinel)
+	{
+		struct Link* next = link->next;
+		free(link);
+		link = next;
+	}
+	pthread_mutex_destroy(&list->frontLock);
+	pthread_mutex_destroy(&list->backLock);
+	free(list);
+}
+
+/**
+	Returns the number of values in the deque. The result is only a
+	snapshot while other threads are adding or removing.
+	param:	list 	struct ConcurrentLinkedList ptr
+	pre: 	list is not null
+	ret:	number of values not yet claimed by a remove
+ */
+int concurrentListSize(struct ConcurrentLinkedList* list)
+{
+	assert(list != 0);
+	return __atomic_load_n(&list->count, __ATOMIC_SEQ_CST);
+}
+
+/**
+	Adds a value at one end of the deque.
+	param:	list 	struct ConcurrentLinkedList ptr
+	param:	value	TYPE
+	param:	front	nonzero for the front, zero for the back
+ */
+static void addEnd(struct ConcurrentLinkedList* list, TYPE value, int front)
+{
+	pthread_mutex_t* lock = front ? &list->frontLock : &list->backLock;
+	struct Link* at;
+
+	pthread_mutex_lock(lock);
+	if (__atomic_load_n(&list->count, __ATOMIC_SEQ_CST) >= 2)
+	{
+		at = front ? list->frontSentinel.next : &list->backSentinel;
+		addLinkBefore(at, value);
+		__atomic_fetch_add(&list->count, 1, __ATOMIC_SEQ_CST);
+		pthread_mutex_unlock(lock);
+		return;
+	}
+	pthread_mutex_unlock(lock);
+
+	/* nearly empty: the ends share links, so take both locks */
+	pthread_mutex_lock(&list->frontLock);
+	pthread_mutex_lock(&list->backLock);
+	at = front ? list->frontSentinel.next : &list->backSentinel;
+	addLinkBefore(at, value);
+	__atomic_fetch_add(&list->count, 1, __ATOMIC_SEQ_CST);
+	pthread_mutex_unlock(&list->backLock);
+	pthread_mutex_unlock(&list->frontLock);
+}
+
+/**
+	Removes the value at one end of the deque.
+	param:	list 	struct ConcurrentLinkedList ptr
+	param:	value	receives the removed value (may be NULL)
+	param:	front	nonzero for the front, zero for the back
+	ret:	1 if a value was removed, 0 if the deque was empty
+ */
+static int removeEnd(struct ConcurrentLinkedList* list, TYPE* value, int front)
+{
+	pthread_mutex_t* lock = front ? &list->frontLock : &list->backLock;
+	struct Link* link;
+	TYPE removed;
+
+	pthread_mutex_lock(lock);
+	if (claimLink(list, 3))
+	{
+		link = front ? list->frontSentinel.next : list->backSentinel.prev;
+		removed = removeLink(link);
+		pthread_mutex_unlock(lock);
+		if (value != 0)
+			*value = removed;
+		return 1;
+	}
+	pthread_mutex_unlock(lock);
+
+	/* nearly empty: the ends share links, so take both locks */
+	int found = 0;
+	pthread_mutex_lock(&list->frontLock);
+	pthread_mutex_lock(&list->backLock);
+	if (claimLink(list, 1))
+	{
+		link = front ? list->frontSentinel.next : list->backSentinel.prev;
+		removed = removeLink(link);
+		if (value != 0)
+			*value = removed;
+		found = 1;
+	}
+	pthread_mutex_unlock(&list->backLock);
+	pthread_mutex_unlock(&list->frontLock);
+	return found;
+}
+
+/**
+	Adds a value to the front of the deque.
+	param: 	list 	struct ConcurrentLinkedList ptr
+	param: 	value 	TYPE
+	pre: 	list is not null
+ */
+void concurrentListAddFront(struct ConcurrentLinkedList* list, TYPE value)
+{
+	assert(list != 0);
+	addEnd(list, value, 1);
+}
+
+/**
+	Adds a value to the back of the deque.
+	param: 	list 	struct ConcurrentLinkedList ptr
+	param: 	value 	TYPE
+	pre: 	list is not null
+ */
+void concurrentListAddBack(struct ConcurrentLinkedList* list, TYPE value)
+{
+	assert(list != 0);
+	addEnd(list, value, 0);
+}
+
+/**
+	Removes the value at the front of the deque. Reading and removing
+	happen as one step, since another thread may change the front
+	between separate calls.
+	param: 	list 	struct ConcurrentLinkedList ptr
+	param: 	value 	receives the removed value (may be NULL)
+	pre: 	list is not null
+	ret:	1 if a value was removed, 0 if the deque was empty
+ */
+int concurrentListRemoveFront(struct ConcurrentLinkedList* list, TYPE* value)
+{
+	assert(list != 0);
+	return removeEnd(list, value, 1);
+}
+
+/**
+	Removes the value at the back of the deque. Reading and removing
+	happen as one step, since another thread may change the back
+	between separate calls.
+	param: 	list 	struct ConcurrentLinkedList ptr
+	param: 	value 	receives the removed value (may be NULL)
+	pre: 	list is not null
+	ret:	1 if a value was removed, 0 if the deque was empty
+ */
+int concurrentListRemoveBack(struct ConcurrentLinkedList* list, TYPE* value)
+{
+	assert(list != 0);
+	return removeEnd(list, value, 0);
+}
@@ -0,0 +1,21 @@
+#ifndef CONCURRENT_LINKED_LIST_H
+#define CONCURRENT_LINKED_LIST_H
+
+#ifndef TYPE
+#define TYPE int
+#endif
+
+struct ConcurrentLinkedList;
+
+struct ConcurrentLinkedList* concurrentListCreate();
+void concurrentListDestroy(struct ConcurrentLinkedList* list);
+int concurrentListSize(struct ConcurrentLinkedList* list);
+
+// Deque interface (safe to call from any number of threads)
+
+void concurrentListAddFront(struct ConcurrentLinkedList* list, TYPE value);
+void concurrentListAddBack(struct ConcurrentLinkedList* list, TYPE value);
+int concurrentListRemoveFront(struct ConcurrentLinkedList* list, TYPE* value);
+int concurrentListRemoveBack(struct ConcurrentLinkedList* list, TYPE* value);
+
+#endif
@@ -0,0 +1,196 @@
+/***********************************************************
+* Filename: concurrentListBench.c
+*
+* Overview:
+*   Stress benchmark for the concurrent deque. For 1, 2, 4, 8,
+*	16 and 32 producer/consumer pairs, producers add values
+*	(even-numbered threads at the back, odd at the front) while
+*	consumers remove them (even at the front, odd at the back),
+*	and the total throughput is reported for:
+*		- locked: linkedList.c behind one global mutex
+*		- concurrent: concurrentLinkedList.c (one lock per end)
+*	Every run checks that each produced value was consumed
+*	exactly once (by comparing sums).
+*
+* Usage:
+*	1) make -f makefileLLDequeBag stress
+*	2) ./stress [values per run]
+************************************************************/
+#define _POSIX_C_SOURCE 199309L
+#include "linkedList.h"
+#include "concurrentLinkedList.h"
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+
+#define MAX_THREADS 32
+
+// Arguments shared by every thread of one run
+struct Run
+{
+	struct LinkedList* locked;				// used when concurrent is NULL
+	pthread_mutex_t lock;
+	struct ConcurrentLinkedList* concurrent;
+	long perThread;							// values added by each producer
+	long long consumedSum[MAX_THREADS];
+};
+
+struct Worker
+{
+	struct Run* run;
+	int id;
+};
+
+/**
+	Returns a monotonic timestamp in nanoseconds.
+ */
+static double nowNs()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static void* produce(void* arg)
+{
+	struct Worker* worker = arg;
+	struct Run* run = worker->run;
+
+	for (long i = 1; i <= run->perThread; i++)
+	{
+		if (run->concurrent != 0)
+		{
+			if (worker->id % 2 == 0)
+				concurrentListAddBack(run->concurrent, (TYPE)i);
+			else
+				concurrentListAddFront(run->concurrent, (TYPE)i);
+		}
+		else
+		{
+			pthread_mutex_lock(&run->lock);
+			if (worker->id % 2 == 0)
+				linkedListAddBack(run->locked, (TYPE)i);
+			else
+				linkedListAddFront(run->locked, (TYPE)i);
+			pthread_mutex_unlock(&run->lock);
+		}
+	}
+	return 0;
+}
+
+static void* consume(void* arg)
+{
+	struct Worker* worker = arg;
+	struct Run* run = worker->run;
+	long long sum = 0;
+
+	for (long taken = 0; taken < run->perThread; )
+	{
+		TYPE value;
+		int found = 0;
+
+		if (run->concurrent != 0)
+		{
+			if (worker->id % 2 == 0)
+				found = concurrentListRemoveFront(run->concurrent, &value);
+			else
+				found = concurrentListRemoveBack(run->concurrent, &value);
+		}
+		else
+		{
+			pthread_mutex_lock(&run->lock);
+			if (!linkedListIsEmpty(run->locked))
+			{
+				if (worker->id % 2 == 0)
+				{
+					value = linkedListFront(run->locked);
+					linkedListRemoveFront(run->locked);
+				}
+				else
+				{
+					value = linkedListBack(run->locked);
+					linkedListRemoveBack(run->locked);
+				}
+				found = 1;
+			}
+			pthread_mutex_unlock(&run->lock);
+		}
+
+		if (found)
+		{
+			sum += value;
+			taken++;
+		}
+		else
+		{
+			sched_yield();
+		}
+	}
+	run->consumedSum[worker->id] = sum;
+	return 0;
+}
+
+/**
+	Runs pairs producer/consumer pairs over one deque and returns the
+	throughput in millions of (add + remove) operations per second.
+ */
+static double runPairs(int concurrent, int pairs, long total)
+{
+	struct Run run;
+	pthread_t producers[MAX_THREADS];
+	pthread_t consumers[MAX_THREADS];
+	struct Worker workers[MAX_THREADS];
+
+	run.perThread = total / pairs;
+	run.concurrent = concurrent ? concurrentListCreate() : 0;
+	run.locked = concurrent ? 0 : linkedListCreate();
+	pthread_mutex_init(&run.lock, NULL);
+
+	double start = nowNs();
+	for (int i = 0; i < pairs; i++)
+	{
+		workers[i].run = &run;
+		workers[i].id = i;
+		pthread_create(&consumers[i], NULL, consume, &workers[i]);
+		pthread_create(&producers[i], NULL, produce, &workers[i]);
+	}
+	for (int i = 0; i < pairs; i++)
+	{
+		pthread_join(producers[i], NULL);
+		pthread_join(consumers[i], NULL);
+	}
+	double elapsed = nowNs() - start;
+
+	/* every value 1..perThread was added once per producer */
+	long long expected = (long long)pairs * run.perThread * (run.perThread + 1) / 2;
+	long long consumed = 0;
+	for (int i = 0; i < pairs; i++)
+		consumed += run.consumedSum[i];
+	if (consumed != expected)
+		printf("MISMATCH: consumed %lld, expected %lld\n", consumed, expected);
+
+	if (concurrent)
+		concurrentListDestroy(run.concurrent);
+	else
+		linkedListDestroy(run.locked);
+	pthread_mutex_destroy(&run.lock);
+
+	return 2.0 * pairs * run.perThread / elapsed * 1e3;
+}
+
+int main(int argc, char** argv)
+{
+	long total = (argc > 1) ? atol(argv[1]) : 2000000;
+
+	printf("%-8s %14s %14s\n", "pairs", "locked Mop/s", "concurrent Mop/s");
+	for (int pairs = 1; pairs <= MAX_THREADS; pairs *= 2)
+	{
+		double locked = runPairs(0, pairs, total);
+		double concurrent = runPairs(1, pairs, total);
+		printf("%-8d %14.2f %14.2f\n", pairs, locked, concurrent);
+	}
+	return 0;
+}
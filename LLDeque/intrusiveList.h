@@ -0,0 +1,256 @@
+#ifndef INTRUSIVE_LIST_H
+#define INTRUSIVE_LIST_H
+
+/***********************************************************
+* Filename: intrusiveList.h
+*
+* Overview:
+*   Intrusive variant of the linked list deque and bag. Rather
+*	than the list allocating a link that holds a copy of each
+*	value, callers embed a struct ListHook in their own struct
+*	and hand the list a pointer to it:
+*
+*		struct Particle
+*		{
+*			double mass;
+*			struct ListHook hook;
+*		};
+*
+*		intrusiveListAddBack(&list, &particle->hook);
+*		struct Particle* p = INTRUSIVE_LIST_ENTRY(
+*			intrusiveListFront(&list), struct Particle, hook);
+*
+*	The list never allocates or frees: the caller owns both the
+*	struct IntrusiveList and every element, and an element must
+*	stay alive (and in one list per hook) while it is linked.
+*	Like linkedList.c, the list has a front and a back sentinel
+*	(embedded in the list struct here) and double links, so
+*	every deque operation and unlinking a known element are O(1).
+*
+*	Bag lookups compare elements through a caller-supplied
+*	function, eq(hook, key), that returns nonzero on a match.
+************************************************************/
+#include <assert.h>
+#include <stddef.h>
+#include <stdio.h>
+
+/* returns the struct TYPE that embeds HOOK as its MEMBER field */
+#define INTRUSIVE_LIST_ENTRY(HOOK, TYPE, MEMBER) \
+	((TYPE*)((char*)(HOOK) - offsetof(TYPE, MEMBER)))
+
+/* iterates HOOK over the list's elements, front to back;
+   HOOK must not be unlinked inside the loop */
+#define INTRUSIVE_LIST_FOR_EACH(HOOK, LIST) \
+	for ((HOOK) = (LIST)->frontSentinel.next; (HOOK) != &(LIST)->backSentinel; (HOOK) = (HOOK)->next)
+
+// Double link embedded in each element
+struct ListHook
+{
+	struct ListHook* next;
+	struct ListHook* prev;
+};
+
+// Double linked list with front and back sentinels
+struct IntrusiveList
+{
+	struct ListHook frontSentinel;
+	struct ListHook backSentinel;
+	int size;
+};
+
+/**
+	Initializes an empty list in caller-owned storage.
+	param:	list	struct IntrusiveList ptr
+	pre:	list is not null
+	post:	list's sentinels point at each other and size is 0
+ */
+static inline void intrusiveListInit(struct IntrusiveList* list)
+{
+	assert(list != 0);
+	list->frontSentinel.next = &list->backSentinel;
+	list->frontSentinel.prev = NULL;
+	list->backSentinel.prev = &list->frontSentinel;
+	list->backSentinel.next = NULL;
+	list->size = 0;
+}
+
+/**
+	Links an element in before the given hook.
+	param:	list	struct IntrusiveList ptr
+	param:	at		struct ListHook ptr in list (or the back sentinel)
+	param:	hook	struct ListHook ptr of an element not in any list
+ */
+static inline void intrusiveListInsertBefore(struct IntrusiveList* list, struct ListHook* at, struct ListHook* hook)
+{
+	assert(list != 0 && at != 0 && hook != 0);
+	assert(at != &list->frontSentinel);
+
+	hook->next = at;
+	hook->prev = at->prev;
+	at->prev->next = hook;
+	at->prev = hook;
+	list->size += 1;
+}
+
+/**
+	Unlinks an element from the list in O(1). The element itself is
+	left to the caller.
+	param:	list	struct IntrusiveList ptr
+	param:	hook	struct ListHook ptr in list
+	post:	hook's pointers are cleared
+ */
+static inline void intrusiveListUnlink(struct IntrusiveList* list, struct ListHook* hook)
+{
+	assert(list != 0 && hook != 0);
+	assert(hook != &list->frontSentinel && hook != &list->backSentinel);
+	assert(hook->next != 0 && hook->prev != 0);
+
+	hook->prev->next = hook->next;
+	hook->next->prev = hook->prev;
+	hook->next = NULL;
+	hook->prev = NULL;
+	list->size -= 1;
+}
+
+static inline int intrusiveListIsEmpty(struct IntrusiveList* list)
+{
+	assert(list != 0);
+	return list->size == 0;
+}
+
+static inline int intrusiveListSize(struct IntrusiveList* list)
+{
+	assert(list != 0);
+	return list->size;
+}
+
+// Deque interface
+
+static inline void intrusiveListAddFront(struct IntrusiveList* list, struct ListHook* hook)
+{
+	assert(list != 0);
+	intrusiveListInsertBefore(list, list->frontSentinel.next, hook);
+}
+
+static inline void intrusiveListAddBack(struct IntrusiveList* list, struct ListHook* hook)
+{
+	assert(list != 0);
+	intrusiveListInsertBefore(list, &list->backSentinel, hook);
+}
+
+static inline struct ListHook* intrusiveListFront(struct IntrusiveList* list)
+{
+	assert(list != 0 && list->size > 0);
+	return list->frontSentinel.next;
+}
+
+static inline struct ListHook* intrusiveListBack(struct IntrusiveList* list)
+{
+	assert(list != 0 && list->size > 0);
+	return list->backSentinel.prev;
+}
+
+/**
+	Unlinks the front element.
+	param:	list	struct IntrusiveList ptr
+	pre:	list is not empty
+	ret:	the unlinked element's hook
+ */
+static inline struct ListHook* intrusiveListRemoveFront(struct IntrusiveList* list)
+{
+	struct ListHook* hook = intrusiveListFront(list);
+	intrusiveListUnlink(list, hook);
+	return hook;
+}
+
+/**
+	Unlinks the back element.
+	param:	list	struct IntrusiveList ptr
+	pre:	list is not empty
+	ret:	the unlinked element's hook
+ */
+static inline struct ListHook* intrusiveListRemoveBack(struct IntrusiveList* list)
+{
+	struct ListHook* hook = intrusiveListBack(list);
+	intrusiveListUnlink(list, hook);
+	return hook;
+}
+
+/**
+	Prints the list's elements front to back.
+	param:	list	struct IntrusiveList ptr
+	param:	out		FILE to print to
+	param:	print	prints one element's value
+ */
+static inline void intrusiveListPrint(struct IntrusiveList* list, FILE* out,
+	void (*print)(FILE* out, const struct ListHook* hook))
+{
+	assert(list != 0 && print != 0);
+	if (intrusiveListIsEmpty(list))
+	{
+		fprintf(out, "Deque's list is empty...\n");
+		return;
+	}
+	fprintf(out, "Printing the deque's list of values...\n");
+	struct ListHook* hook;
+	INTRUSIVE_LIST_FOR_EACH(hook, list)
+	{
+		print(out, hook);
+	}
+	fprintf(out, "\n");
+}
+
+// Bag interface
+
+static inline void intrusiveListAdd(struct IntrusiveList* bag, struct ListHook* hook)
+{
+	intrusiveListAddFront(bag, hook);
+}
+
+/**
+	Returns the first element for which eq(hook, key) is nonzero.
+	param:	bag		struct IntrusiveList ptr
+	param:	key		value passed through to eq
+	param:	eq		compares an element with key
+	ret:	the matching element's hook, or NULL
+ */
+static inline struct ListHook* intrusiveListFind(struct IntrusiveList* bag, const void* key,
+	int (*eq)(const struct ListHook* hook, const void* key))
+{
+	assert(bag != 0 && eq != 0);
+	struct ListHook* hook;
+	INTRUSIVE_LIST_FOR_EACH(hook, bag)
+	{
+		if (eq(hook, key))
+		{
+			return hook;
+		}
+	}
+	return NULL;
+}
+
+static inline int intrusiveListContains(struct IntrusiveList* bag, const void* key,
+	int (*eq)(const struct ListHook* hook, const void* key))
+{
+	return intrusiveListFind(bag, key, eq) != NULL;
+}
+
+/**
+	Unlinks the first element for which eq(hook, key) is nonzero.
+	param:	bag		struct IntrusiveList ptr
+	param:	key		value passed through to eq
+	param:	eq		compares an element with key
+	ret:	the unlinked element's hook, or NULL if none matched
+ */
+static inline struct ListHook* intrusiveListRemove(struct IntrusiveList* bag, const void* key,
+	int (*eq)(const struct ListHook* hook, const void* key))
+{
+	struct ListHook* hook = intrusiveListFind(bag, key, eq);
+	if (hook != NULL)
+	{
+		intrusiveListUnlink(bag, hook);
+	}
+	return hook;
+}
+
+#endif
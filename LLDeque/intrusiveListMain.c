@@ -0,0 +1,65 @@
+#include "intrusiveList.h"
+#include <stdio.h>
+#include <assert.h>
+
+/* elements live in the caller's own storage and embed their hook */
+struct Particle
+{
+	int id;
+	double mass;
+	double position[3];
+	struct ListHook hook;
+};
+
+static void printParticle(FILE* out, const struct ListHook* hook)
+{
+	const struct Particle* p = INTRUSIVE_LIST_ENTRY(hook, const struct Particle, hook);
+	fprintf(out, "%d ", p->id);
+}
+
+static int particleHasId(const struct ListHook* hook, const void* key)
+{
+	return INTRUSIVE_LIST_ENTRY(hook, const struct Particle, hook)->id == *(const int*)key;
+}
+
+int main(){
+	struct Particle particles[4] = {
+		{ 1, 1.0, { 0, 0, 0 } },
+		{ 2, 2.0, { 1, 0, 0 } },
+		{ 3, 3.0, { 0, 1, 0 } },
+		{ 4, 4.0, { 0, 0, 1 } },
+	};
+	struct IntrusiveList list;
+
+	/* DEQUE */
+	intrusiveListInit(&list);
+	intrusiveListAddFront(&list, &particles[0].hook);
+	intrusiveListAddBack(&list, &particles[1].hook);
+	intrusiveListAddFront(&list, &particles[2].hook);
+	intrusiveListPrint(&list, stdout, printParticle);
+	printf("%d\n", INTRUSIVE_LIST_ENTRY(intrusiveListFront(&list), struct Particle, hook)->id);
+	printf("%d\n", INTRUSIVE_LIST_ENTRY(intrusiveListBack(&list), struct Particle, hook)->id);
+	intrusiveListRemoveFront(&list);
+	intrusiveListRemoveBack(&list);
+	intrusiveListPrint(&list, stdout, printParticle);
+	intrusiveListRemoveFront(&list);
+	assert(intrusiveListIsEmpty(&list));
+
+	/* BAG */
+	for (int i = 0; i < 4; i++)
+	{
+		intrusiveListAdd(&list, &particles[i].hook);
+	}
+	int id = 3;
+	assert(intrusiveListContains(&list, &id, particleHasId));
+	struct ListHook* removed = intrusiveListRemove(&list, &id, particleHasId);
+	assert(INTRUSIVE_LIST_ENTRY(removed, struct Particle, hook) == &particles[2]);
+	assert(!intrusiveListContains(&list, &id, particleHasId));
+
+	/* an element known to the caller unlinks in O(1) */
+	intrusiveListUnlink(&list, &particles[0].hook);
+	intrusiveListPrint(&list, stdout, printParticle);
+	assert(intrusiveListSize(&list) == 2);
+
+	return 0;
+}
@@ -23,16 +23,143 @@
 *	Note that both implementations utilize a linked list with
 *	both a front and back sentinel and double links (links with
 *	next and prev pointers).
+*
+*	Links are not malloc'd one at a time; each list carves them
+*	out of its pool's slabs (fixed-size chunks of links) and keeps
+*	removed links on an intrusive free list for reuse. Destroying
+*	the list releases whole slabs at once. Lists that exchange
+*	links (concat/split) share one pool, so links can move
+*	between them by relinking alone. The pool is not locked, so
+*	such lists belong to one thread, and its slabs are freed
+*	only when the last list sharing it is destroyed.
+*
+*	Lists made with linkedListCreateWithAllocator draw their
+*	header, sentinels, slabs, hash index and bloom filter from
+*	the caller's allocator (see allocator.h) instead of malloc;
+*	a pool remembers the allocator of the list that created it,
+*	and lists only share a pool when their allocators match.
+*	The print scratch buffer and snapshot
+*	handles, which reader threads release, still use malloc.
+*
+*	A list created with LINKED_LIST_HASHED also keeps an
+*	open-addressing (linear probing) hash index from value to
+*	link, so the bag's contains/remove are expected O(1). Each
+*	value has one slot however many links hold it; repeated
+*	values chain their links through a second table keyed by
+*	link, so any one of them can be unindexed in O(1).
+*	A list created with LINKED_LIST_BLOOM keeps a bloom filter
+*	of its values, so most lookups of absent values are answered
+*	without a traversal; removals cannot clear bits, so the
+*	filter is rebuilt lazily once enough links have been removed.
+*	A list created with LINKED_LIST_MOVE_TO_FRONT or
+*	LINKED_LIST_TRANSPOSE reorders itself on successful
+*	contains lookups (found link moved to the front, or one
+*	step toward it), so frequently searched values are found
+*	after a few hops.
+*
+*	linkedListSnapshot gives other threads an O(1) read-only
+*	view of the list. Snapshot readers walk a fixed number of
+*	links forward from a pinned first link, so the writer may
+*	keep changing prev pointers and the next pointer of the
+*	last shared link (adds at either end, removes at the front)
+*	without copying anything; links it removes while snapshots
+*	are live are retired rather than reused. Removing any other
+*	shared link (the back, or a bag value) first replaces just
+*	the shared links before it with copies, making it the first
+*	shared link; anything else that would rewrite a shared next
+*	pointer (sort, splice, move-to-front) copies them all.
+*
+*	Building with -DLINKED_LIST_STATS instruments every list:
+*	per-operation call counts and log2-bucketed latency
+*	histograms, bag scan lengths, peak size and bytes allocated,
+*	read with linkedListStats/linkedListStatsDump. A destroyed
+*	list's counters are added to process-wide totals, read with
+*	linkedListStatsDestroyed; the totals sit behind a spin lock,
+*	so lists may be destroyed from any thread. A list's own
+*	counters are as unsynchronized as the list itself. Without
+*	it the instrumentation compiles to nothing.
+*
+*	Lists can be saved to a binary image (a header followed by
+*	the values front to back) and loaded back by mapping the
+*	file and adding all of its values with one bulk allocation.
 ************************************************************/
+#define _POSIX_C_SOURCE 200809L
 #include "linkedList.h"
+#include "../printBuffer.h"
 #include <assert.h>
 #include <stdlib.h>
 #include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#ifdef LINKED_LIST_STATS
+#include <time.h>
+#endif
 
 #ifndef FORMAT_SPECIFIER
 #define FORMAT_SPECIFIER "%d"
 #endif
 
+/* writes V's text at char* P (at most PRINT_VALUE_MAX chars), returns its length;
+   must agree with FORMAT_SPECIFIER */
+#ifndef FORMAT_VALUE
+#define FORMAT_VALUE(P, V) formatInteger((P), (long long)(V))
+#endif
+#define PRINT_VALUE_MAX 64
+
+/* number of links in the first slab when no capacity hint is given */
+#ifndef SLAB_DEFAULT_CAPACITY
+#define SLAB_DEFAULT_CAPACITY 64
+#endif
+
+/* upper bound on the size of slabs added as the list grows */
+#ifndef SLAB_MAX_CAPACITY
+#define SLAB_MAX_CAPACITY 4096
+#endif
+
+/* initial number of slots in a hashed list's index (power of 2) */
+#ifndef INDEX_MIN_CAPACITY
+#define INDEX_MIN_CAPACITY 16
+#endif
+
+/* identifies a saved list image; read back byte-swapped on another endianness */
+#define IMAGE_MAGIC 0x4C4C5354u		// "LLST"
+#define IMAGE_VERSION 1u
+
+/* values buffered per write when saving */
+#define IMAGE_WRITE_VALUES 4096
+
+/* bloom filter bits per value it is sized for, and bits set per value */
+#define BLOOM_BITS_PER_VALUE 10
+#define BLOOM_HASHES 4
+
+/* removals tolerated before the bloom filter is rebuilt: this many,
+   or a quarter of the values it holds, whichever is larger */
+#ifndef BLOOM_MIN_STALE
+#define BLOOM_MIN_STALE 64
+#endif
+
+#ifdef LINKED_LIST_STATS
+/* times the enclosing API call on LIST as OP, recording it when the
+   call's scope exits (by any return); LIST is read at exit, so a call
+   that creates its list is counted on it; needs GCC/Clang's cleanup attribute */
+#define STATS_CALL(LIST, OP) \
+	struct StatsCall statsCall __attribute__((cleanup(statsRecord))) = { &(LIST), (OP), statsNow() }
+#define STATS_ALLOCATED(LIST, BYTES) ((LIST)->stats.bytesAllocated += (long)(BYTES))
+#define STATS_SCAN(LIST, LINKS) statsScan((LIST), (LINKS))
+#else
+#define STATS_CALL(LIST, OP) ((void)0)
+#define STATS_ALLOCATED(LIST, BYTES) ((void)0)
+#define STATS_SCAN(LIST, LINKS) ((void)0)
+#endif
+
+/* marks an index slot whose link was removed, so probing continues past it */
+static struct Link indexTombstone;
+#define TOMBSTONE (&indexTombstone)
+
 // Double link
 struct Link
 {
@@ -41,440 +168,2930 @@ struct Link
 	struct Link* prev;
 };
 
+// Hash index slot: the links holding one value
+struct IndexSlot
+{
+	struct Link* link;		// head of the value's chain; NULL if empty, TOMBSTONE if removed
+	int count;				// links holding the value
+};
+
+// Equal-value chain entry of a link whose value more than one link holds
+struct EqualLinks
+{
+	struct Link* link;		// key; NULL if empty, TOMBSTONE if removed
+	struct Link* next;		// next link in the chain, or NULL
+	struct Link* prev;		// previous link in the chain, or NULL for the head
+};
+
+// Read-only view of a list: size values from first onwards
+struct LinkedListSnapshot
+{
+	struct LinkedList* list;
+	struct Link* first;
+	int size;
+};
+
+// Header of a saved list image, followed by count TYPE values
+struct ListImage
+{
+	uint32_t magic;
+	uint32_t version;
+	uint32_t valueSize;		// sizeof(TYPE) of the saving build
+	uint32_t reserved;
+	uint64_t count;
+};
+
+// Fixed-size chunk of links, carved out front to back
+struct Slab
+{
+	struct Slab* next;
+	int capacity;
+	int used;
+	struct Link links[];
+};
+
+// Slabs and free links shared by the lists whose links they hold
+struct LinkPool
+{
+	struct Slab* slabs;			// current slab first
+	struct Slab* lastSlab;
+	struct Link* freeLinks;		// removed links, chained through next
+	struct Link* lastFreeLink;
+	struct LinkPool* forward;	// pool this one was merged into, if any
+	int refs;					// lists and merged pools referring to this pool
+	struct Allocator allocator;	// source of the pool and its slabs
+};
+
 // Double linked list with front and back sentinels
 struct LinkedList
 {
 	struct Link* frontSentinel;
 	struct Link* backSentinel;
 	int size;
+	struct LinkPool* pool;		// where the list's links are allocated
+	struct Allocator allocator;	// source of everything else the list owns
+	int flags;					// LINKED_LIST_* creation flags
+	struct IndexSlot* index;	// hash index slots, one per value (LINKED_LIST_HASHED only)
+	int indexCapacity;			// number of slots, a power of 2
+	int indexFilled;			// slots holding a value or a tombstone
+	int indexKeys;				// slots holding a value
+	struct EqualLinks* equal;	// chains of links holding the same value, keyed by link
+	int equalCapacity;			// number of entries, a power of 2 (0 until a value repeats)
+	int equalFilled;			// entries holding a link or a tombstone
+	int equalLinks;				// entries holding a link
+	uint64_t* bloom;			// bloom filter bits (LINKED_LIST_BLOOM only)
+	int bloomBits;				// number of bits, a power of 2
+	int bloomValues;			// values added since the last rebuild
+	int bloomStale;				// values removed since the last rebuild
+	struct LinkedListBloomStats bloomStats;
+	long probes;				// links visited by bag lookup scans
+	struct Link* sharedFirst;	// run of links that live snapshots may read, or NULL
+	struct Link* sharedLast;
+	int snapshots;				// live snapshots; accessed atomically
+	struct Link** retired;		// removed links snapshots may still read
+	int retiredCount;
+	int retiredCapacity;
+#ifdef LINKED_LIST_STATS
+	struct LinkedListStats stats;
+#endif
 };
 
-/* FIXME: You will write this function */
-/**
-  	Allocates the list's sentinel and sets the size to 0.
-  	The sentinels' next and prev should point to eachother or NULL
-  	as appropriate.
-	param: 	list 	struct LinkedList ptr
-	pre: 	list is not null
-	post: 	list front and back sentinel not null
-			front sentinel next points to back
-			front sentinel prev points to null
-			back sentinel prev points to front
-			back sentinel next points to null
-			list size is 0
- */
-static void init(struct LinkedList* list) 
+#ifdef LINKED_LIST_STATS
+// An API call being timed by STATS_CALL
+struct StatsCall
 {
-	/* validate list != NULL */
-	assert(list != 0);
-
-	/* allocate memory for both sentinels */
-	struct Link* fSentinel = (struct Link*)malloc(sizeof(struct Link));
-	struct Link* bSentinel = (struct Link*)malloc(sizeof(struct Link));
+	struct LinkedList* const* list;		// variable holding the list; NULL if none was made
+	enum LinkedListOp op;
+	long long start;
+};
 
-	/* point LL sentinel pointers to the proper memory addresses */
-	list->frontSentinel = fSentinel;
-	list->backSentinel = bSentinel;
+static const char* const statsOpNames[LINKED_LIST_OPS] = {
+	"create", "destroy", "isEmpty", "addFront", "addBack", "front", "back", "removeFront", "removeBack",
+	"addFrontN", "addBackN", "removeFrontN", "removeBackN",
+	"concat", "splitAt", "sort", "add", "contains", "remove",
+	"removeAll", "removeIf", "print", "save", "load", "snapshot"
+};
 
-	list->frontSentinel->next = list->backSentinel;
-	list->backSentinel->prev = list->frontSentinel;
+/* counters of every list destroyed so far, summed; guarded by destroyedLock */
+static struct LinkedListStats destroyedStats;
+static char destroyedLock;
 
-	/* update sentinel and list values */
-	list->frontSentinel->value = 0;
-	list->backSentinel->value = 0;
-	list->size = 0;
+/**
+	Takes destroyedLock, spinning while another thread holds it (it is
+	held only to copy or add up one struct LinkedListStats).
+ */
+static void statsLockDestroyed()
+{
+	while (__atomic_test_and_set(&destroyedLock, __ATOMIC_ACQUIRE))
+	{
+		/* spin */
+	}
 }
 
-/* FIXME: You will write this function */
 /**
- 	Adds a new link with the given value before the given link and
-	increments the list's size.
- 	param: 	list 	struct LinkedList ptr
- 	param:	link 	struct Link ptr
- 	param: 	TYPE
-	pre: 	list and link are not null
-	post: 	newLink is not null
-			newLink w/ given value is added before param link
-			list size is incremented by 1
+	Releases destroyedLock.
  */
-static void addLinkBefore(struct LinkedList* list, struct Link* link, TYPE value)
+static void statsUnlockDestroyed()
 {
-	/* assertions for validation */
-	assert(list != 0);
-	assert(link != 0);
+	__atomic_clear(&destroyedLock, __ATOMIC_RELEASE);
+}
 
-	/* initialize a new node, which will be inserted into the LL */
-	struct Link* node = (struct Link*)malloc(sizeof(struct Link));
-	node->value = value;
+/**
+	Returns a monotonic timestamp in nanoseconds.
+ */
+static long long statsNow()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
 
-	/* find the node that the new node must be inserted immediately before */
-	struct Link* temp = list->frontSentinel;
-	while (temp->next != link)
+/**
+	Returns the histogram bucket of a sample: floor(log2(sample)),
+	with 0 and 1 in bucket 0 and large samples in the last bucket.
+ */
+static int statsBucket(long long sample)
+{
+	int bucket = 0;
+	while (sample > 1 && bucket < LINKED_LIST_HISTOGRAM_BUCKETS - 1)
 	{
-		temp = temp->next;
+		sample >>= 1;
+		bucket++;
 	}
+	return bucket;
+}
 
-	/* insert the new node & update pointers of nodes within the list */
-	node->next = link;
-	temp->next = node;
-	assert(temp->next == node && node->next == link);
-
-	link->prev = node;
-	node->prev = temp;
-	assert(link->prev == node && node->prev == temp);
+/**
+	Records a finished API call: its count, latency and the list's
+	size afterwards. Called through the cleanup attribute.
+	param:	call	struct StatsCall ptr
+ */
+static void statsRecord(struct StatsCall* call)
+{
+	struct LinkedList* list = *call->list;
+	if (list == 0)
+	{
+		return;
+	}
+	struct LinkedListStats* stats = &list->stats;
+	long long elapsed = statsNow() - call->start;
 
-	/* increase the LL's size by 1 */
-	list->size += 1;
+	stats->calls[call->op] += 1;
+	stats->totalNs[call->op] += elapsed;
+	stats->latency[call->op][statsBucket(elapsed)] += 1;
+	if (list->size > stats->peakSize)
+	{
+		stats->peakSize = list->size;
+	}
 }
 
-/* FIXME: You will write this function */
 /**
-	Removes the given link from the list and
-	decrements the list's size.
-	param: 	list 	struct LinkedList ptr
- 	param:	link 	struct Link ptr
-	pre: 	list and link are not null
-	post: 	param link is removed from param list
-			memory allocated to link is freed
-			list size is decremented by 1
+	Records a list's destroy call, begun at start, and adds the list's
+	counters to those of the lists destroyed before it. Lists may be
+	destroyed from any thread; the totals are updated under
+	destroyedLock.
+	param:	list	struct LinkedList ptr, about to be freed
+	param:	start	statsNow() when linkedListDestroy was called
  */
-static void removeLink(struct LinkedList* list, struct Link* link)
+static void statsRetire(struct LinkedList* list, long long start)
 {
-	/* assertions for validation (list & link are not NULL */
-	assert(list != 0);
-	assert(link != 0);
-
-	/* temp pointer to the front sentinel */
-	struct Link* temp = list->frontSentinel;
+	struct StatsCall call = { &list, LINKED_LIST_OP_DESTROY, start };
+	statsRecord(&call);
 
-	/* find the node that needs to be removed */
-	while (temp->next != link)
+	const struct LinkedListStats* stats = &list->stats;
+	statsLockDestroyed();
+	for (int op = 0; op < LINKED_LIST_OPS; op++)
+	{
+		destroyedStats.calls[op] += stats->calls[op];
+		destroyedStats.totalNs[op] += stats->totalNs[op];
+		for (int i = 0; i < LINKED_LIST_HISTOGRAM_BUCKETS; i++)
+		{
+			destroyedStats.latency[op][i] += stats->latency[op][i];
+		}
+	}
+	destroyedStats.scans += stats->scans;
+	destroyedStats.scannedLinks += stats->scannedLinks;
+	if (stats->longestScan > destroyedStats.longestScan)
 	{
-		temp = temp->next;
+		destroyedStats.longestScan = stats->longestScan;
 	}
+	for (int i = 0; i < LINKED_LIST_HISTOGRAM_BUCKETS; i++)
+	{
+		destroyedStats.scanLength[i] += stats->scanLength[i];
+	}
+	if (stats->peakSize > destroyedStats.peakSize)
+	{
+		destroyedStats.peakSize = stats->peakSize;
+	}
+	destroyedStats.bytesAllocated += stats->bytesAllocated;
+	statsUnlockDestroyed();
+}
 
-	assert(temp->next == link && link->prev == temp);
+/**
+	Records the number of links a bag lookup traversed.
+	param:	list	struct LinkedList ptr
+	param:	links	links compared against the searched-for value
+ */
+static void statsScan(struct LinkedList* list, long links)
+{
+	struct LinkedListStats* stats = &list->stats;
 
-	/* re-point node pointers */
-	temp->next = link->next;
-	link->next->prev = temp;
+	stats->scans += 1;
+	stats->scannedLinks += links;
+	stats->scanLength[statsBucket(links)] += 1;
+	if (links > stats->longestScan)
+	{
+		stats->longestScan = links;
+	}
+}
+#endif
 
-	/* free the removed node */
-	assert(link != list->frontSentinel && link != list->backSentinel);
-	free(link);
-	list->size -= 1;
+/**
+	Returns the size of a slab holding capacity links.
+ */
+static size_t slabBytes(int capacity)
+{
+	return sizeof(struct Slab) + (size_t)capacity * sizeof(struct Link);
 }
 
 /**
-	Allocates and initializes a list.
-	pre: 	none
-	post: 	memory allocated for new struct LinkedList ptr
-			list init (call to init func)
-	return: list
+	Allocates size bytes from the list's allocator.
+	param: 	list 	struct LinkedList ptr
+	param:	size	bytes requested
+	ret:	memory, which must be returned with listFree
  */
-struct LinkedList* linkedListCreate()
+static void* listAlloc(struct LinkedList* list, size_t size)
 {
-	struct LinkedList* list = malloc(sizeof(struct LinkedList));
-	init(list);
-	return list;
+	void* ptr = list->allocator.alloc(list->allocator.context, size);
+	assert(ptr != 0);
+	return ptr;
 }
 
 /**
-	Deallocates every link in the list including the sentinels,
-	and frees the list itself.
-	param:	list 	struct LinkedList ptr
-	pre: 	list is not null
-	post: 	memory allocated to each link is freed
-			" " front and back sentinel " "
-			" " list " "
+	Returns memory from listAlloc (or NULL) to the list's allocator.
+	param: 	list 	struct LinkedList ptr
+	param:	ptr		memory to free
+	param:	size	bytes that were requested for it
  */
-void linkedListDestroy(struct LinkedList* list)
+static void listFree(struct LinkedList* list, void* ptr, size_t size)
 {
-	assert(list != NULL);
-	while (!linkedListIsEmpty(list)) {
-		linkedListRemoveFront(list);
+	if (ptr != 0)
+	{
+		list->allocator.free(list->allocator.context, ptr, size);
 	}
-	free(list->frontSentinel);
-	free(list->backSentinel);
-	free(list);
-	list = NULL;
 }
 
-/* FIXME: You will write this function */
 /**
-	Adds a new link with the given value to the front of the deque.
-	param: 	deque 	struct LinkedList ptr
-	param: 	value 	TYPE
-	pre: 	deque is not null
-	post: 	link is created w/ param value stored before current first link
-			(call to addLinkBefore)
+	Allocates a new slab holding capacity links and makes it the
+	pool's current slab.
+	param: 	pool 		struct LinkPool ptr
+	param:	capacity 	number of links in the slab
+	pre: 	pool is not null
+	pre:	capacity > 0
+	post: 	new slab is at the head of the pool's slab chain
  */
-void linkedListAddFront(struct LinkedList* deque, TYPE value)
+static void addSlab(struct LinkPool* pool, int capacity)
 {
-	/* assertion for validation (deque is not NULL) */
-	assert(deque != 0);
+	assert(pool != 0);
+	assert(capacity > 0);
 
-	/* temp pointer that represents the first node/link (non-sentinel) */
-	struct Link* temp = deque->frontSentinel->next;
+	struct Slab* slab = pool->allocator.alloc(pool->allocator.context, slabBytes(capacity));
+	assert(slab != 0);
 
-	/* insert the node */
-	addLinkBefore(deque, temp, value);
+	slab->capacity = capacity;
+	slab->used = 0;
+	slab->next = pool->slabs;
+	pool->slabs = slab;
+	if (pool->lastSlab == 0)
+	{
+		pool->lastSlab = slab;
+	}
 }
 
-/* FIXME: You will write this function */
 /**
-	Adds a new link with the given value to the back of the deque.
-	param: 	deque 	struct LinkedList ptr
-	param: 	value 	TYPE
-	pre: 	deque is not null
-	post: 	link is created with given value before current last link
-			(call to addLinkBefore)
+	Allocates a pool whose first slab holds capacity links.
+	param:	allocator	source of the pool and its slabs
+	param:	capacity 	number of links in the first slab
+	pre:	capacity > 0
+	ret:	pool with one reference
  */
-void linkedListAddBack(struct LinkedList* deque, TYPE value)
+static struct LinkPool* poolCreate(const struct Allocator* allocator, int capacity)
 {
-	/* assertion for validation (deque is not NULL) */
-	assert(deque != 0);
-
-	/* node that points to the deque's back sentinel */
-	struct Link* temp = deque->backSentinel;
+	struct LinkPool* pool = allocator->alloc(allocator->context, sizeof(struct LinkPool));
+	assert(pool != 0);
 
-	/* insert the node */
-	addLinkBefore(deque, temp, value);
+	pool->allocator = *allocator;
+	pool->slabs = 0;
+	pool->lastSlab = 0;
+	pool->freeLinks = 0;
+	pool->lastFreeLink = 0;
+	pool->forward = 0;
+	pool->refs = 1;
+	addSlab(pool, capacity);
+	return pool;
 }
 
-/* FIXME: You will write this function */
 /**
-	Returns the value of the link at the front of the deque.
-	param: 	deque 	struct LinkedList ptr
-	pre:	deque is not null
-	pre:	deque is not empty
-	post:	none
-	ret:	first link's value 
+	Drops one reference to a pool. The last reference frees the pool
+	and, unless it was merged into another pool, all of its slabs.
+	param:	pool 	struct LinkPool ptr
+	pre:	pool is not null
  */
-TYPE linkedListFront(struct LinkedList* deque)
+static void poolRelease(struct LinkPool* pool)
 {
-	/* assertions for validation (deque is not NULL & deck is not empty) */
-	assert(deque != 0);
-	assert(deque->size > 0);
-
-	/* return the first node's value in the list (deque) */
-	return deque->frontSentinel->next->value;
+	while (pool != 0 && --pool->refs == 0)
+	{
+		struct LinkPool* forward = pool->forward;
+		struct Allocator allocator = pool->allocator;
+		while (pool->slabs != 0)
+		{
+			struct Slab* next = pool->slabs->next;
+			allocator.free(allocator.context, pool->slabs, slabBytes(pool->slabs->capacity));
+			pool->slabs = next;
+		}
+		allocator.free(allocator.context, pool, sizeof(struct LinkPool));
+		pool = forward;
+	}
 }
 
-/* FIXME: You will write this function */
 /**
-	Returns the value of the link at the back of the deque.
-	param: 	deque 	struct LinkedList ptr
-	pre:	deque is not null
-	pre:	deque is not empty
-	post:	none
-	ret:	last link's value 
+	Returns the pool the list's links are allocated from, following
+	(and then skipping) pools that have been merged into another.
+	param:	list 	struct LinkedList ptr
+	pre:	list is not null
+	ret:	pool that has not been merged
  */
-TYPE linkedListBack(struct LinkedList* deque)
+static struct LinkPool* poolOf(struct LinkedList* list)
 {
-	/* assertions for validation (deque is not NULL & deque is not empty) */
-	assert(deque != 0);
-	assert(deque->size > 0);
+	struct LinkPool* pool = list->pool;
+	if (pool->forward == 0)
+	{
+		return pool;
+	}
 
-	/* return the last node's value in the list (deque) */
-	return deque->backSentinel->prev->value;
+	while (pool->forward != 0)
+	{
+		pool = pool->forward;
+	}
+	pool->refs += 1;
+	poolRelease(list->pool);
+	list->pool = pool;
+	return pool;
 }
 
-/* FIXME: You will write this function */
 /**
-	Removes the link at the front of the deque.
-	param: 	deque 	struct LinkedList ptr
-	pre:	deque is not null
-	pre:	deque is not empty
-	post:	first link is removed and freed (call to removeLink)
+	Moves every slab and free link of one pool into another, so that
+	lists allocated from either can exchange links. The emptied pool
+	forwards to the other one from then on.
+	param:	into 	struct LinkPool ptr
+	param:	from 	struct LinkPool ptr
+	pre:	into and from are different pools that have not been merged
+	pre:	into and from have the same allocator
+	post:	from forwards to into
  */
-void linkedListRemoveFront(struct LinkedList* deque)
+static void poolMerge(struct LinkPool* into, struct LinkPool* from)
 {
-	/* assertions for validation (deque is not NULL & deque is not empty) */
-	assert(deque != 0);
-	assert(deque->size > 0);
+	assert(into != from);
+	assert(into->forward == 0 && from->forward == 0);
+	assert(allocatorSame(&into->allocator, &from->allocator));
 
-	/* variable that points to the first node in the list (deque) */
-	struct Link* front = deque->frontSentinel->next;
+	/* into's current slab stays at the head of the chain */
+	into->lastSlab->next = from->slabs;
+	into->lastSlab = from->lastSlab;
 
-	/* remove the front node/link */
-	removeLink(deque, front);
+	if (from->freeLinks != 0)
+	{
+		if (into->freeLinks == 0)
+		{
+			into->freeLinks = from->freeLinks;
+		}
+		else
+		{
+			into->lastFreeLink->next = from->freeLinks;
+		}
+		into->lastFreeLink = from->lastFreeLink;
+	}
+
+	from->slabs = 0;
+	from->lastSlab = 0;
+	from->freeLinks = 0;
+	from->lastFreeLink = 0;
+	from->forward = into;
+	into->refs += 1;
+}
+
+/**
+	Returns an unused link, taken from the free list if possible,
+	otherwise from the current slab (adding a new, larger slab
+	when the current one is full).
+	param: 	list 	struct LinkedList ptr
+	pre: 	list is not null
+	ret:	link that is not part of the list
+ */
+static struct Link* allocLink(struct LinkedList* list)
+{
+	assert(list != 0);
+	struct LinkPool* pool = poolOf(list);
+
+	/* reuse a previously removed link */
+	if (pool->freeLinks != 0)
+	{
+		struct Link* link = pool->freeLinks;
+		pool->freeLinks = link->next;
+		if (pool->freeLinks == 0)
+		{
+			pool->lastFreeLink = 0;
+		}
+		return link;
+	}
+
+	/* current slab is full; grow geometrically up to SLAB_MAX_CAPACITY
+	   (a larger slab, from a capacity hint or a bulk add, is not repeated) */
+	if (pool->slabs->used == pool->slabs->capacity)
+	{
+		int capacity = pool->slabs->capacity < SLAB_MAX_CAPACITY / 2 ? pool->slabs->capacity * 2 : SLAB_MAX_CAPACITY;
+		addSlab(pool, capacity);
+		STATS_ALLOCATED(list, slabBytes(capacity));
+	}
+
+	return &pool->slabs->links[pool->slabs->used++];
+}
+
+/**
+	Returns a run of links that has been unlinked from the list, and
+	that is still chained front to back through next, to the free
+	list in one step.
+	param: 	list 	struct LinkedList ptr
+	param:	first 	first link of the run
+	param:	last 	last link of the run
+	pre: 	list, first and last are not null
+	post:	every link of the run is on the free list
+ */
+static void freeLinkRun(struct LinkedList* list, struct Link* first, struct Link* last)
+{
+	assert(list != 0);
+	assert(first != 0 && last != 0);
+	struct LinkPool* pool = poolOf(list);
+
+	if (pool->freeLinks == 0)
+	{
+		pool->lastFreeLink = last;
+	}
+	last->next = pool->freeLinks;
+	pool->freeLinks = first;
+}
+
+/**
+	Returns a link that has been unlinked from the list to the
+	free list.
+	param: 	list 	struct LinkedList ptr
+	param:	link 	struct Link ptr
+	pre: 	list and link are not null
+	post:	link is at the head of the free list
+ */
+static void freeLink(struct LinkedList* list, struct Link* link)
+{
+	freeLinkRun(list, link, link);
+}
+
+/**
+	Returns n unused links that are contiguous in memory, carved from
+	the current slab if it has room and from a new slab of exactly n
+	links otherwise.
+	param: 	list 	struct LinkedList ptr
+	param:	n		number of links
+	pre: 	list is not null
+	pre:	n > 0
+	ret:	array of n links that are not part of the list
+ */
+static struct Link* allocLinks(struct LinkedList* list, int n)
+{
+	assert(list != 0);
+	assert(n > 0);
+	struct LinkPool* pool = poolOf(list);
+
+	struct Slab* current = pool->slabs;
+	if (current->capacity - current->used >= n)
+	{
+		struct Link* links = &current->links[current->used];
+		current->used += n;
+		return links;
+	}
+
+	/* dedicated slab; keep a partly used current slab at the head so
+	   single-link allocations continue to draw from it */
+	addSlab(pool, n);
+	STATS_ALLOCATED(list, slabBytes(n));
+	struct Slab* slab = pool->slabs;
+	slab->used = n;
+	if (current->used < current->capacity)
+	{
+		pool->slabs = current;
+		slab->next = current->next;
+		current->next = slab;
+		if (pool->lastSlab == current)
+		{
+			pool->lastSlab = slab;
+		}
+	}
+	return slab->links;
+}
+
+/**
+	Mixes a hash so that every bit of it depends on every bit of the
+	input (MurmurHash3's finalizer). HASH is a multiplication, whose
+	low bits, the ones a power-of-2 table keeps, ignore the high bits
+	of the value: strided values would all share a few slots.
+	param:	h	hash to mix
+	ret:	mixed hash
+ */
+static unsigned int mixHash(unsigned int h)
+{
+	h ^= h >> 16;
+	h *= 0x85ebca6bu;
+	h ^= h >> 13;
+	h *= 0xc2b2ae35u;
+	h ^= h >> 16;
+	return h;
+}
+
+/**
+	Returns the index slot holding a value, or the slot it would be
+	inserted into: the first tombstone passed, else the empty slot
+	that ended the probe.
+	param: 	list 	struct LinkedList ptr
+	param:	value 	TYPE
+	pre: 	list is hashed
+	ret:	slot; its link holds value if the value was found
+ */
+static struct IndexSlot* indexProbe(struct LinkedList* list, TYPE value)
+{
+	unsigned int mask = (unsigned int)list->indexCapacity - 1;
+	unsigned int i = mixHash(HASH(value)) & mask;
+	struct IndexSlot* reuse = 0;
+
+	while (list->index[i].link != 0)
+	{
+		if (list->index[i].link == TOMBSTONE)
+		{
+			if (reuse == 0)
+			{
+				reuse = &list->index[i];
+			}
+		}
+		else if (EQ(list->index[i].link->value, value))
+		{
+			return &list->index[i];
+		}
+		i = (i + 1) & mask;
+	}
+
+	return (reuse != 0) ? reuse : &list->index[i];
+}
+
+/**
+	Rebuilds the index with the given number of slots, dropping
+	all tombstones.
+	param: 	list 		struct LinkedList ptr
+	param:	capacity	new number of slots, a power of 2
+	pre: 	list is hashed
+	pre:	capacity is larger than the number of values indexed
+	post:	index holds every value in the list and no tombstones
+ */
+static void indexRehash(struct LinkedList* list, int capacity)
+{
+	struct IndexSlot* slots = listAlloc(list, (size_t)capacity * sizeof(struct IndexSlot));
+	memset(slots, 0, (size_t)capacity * sizeof(struct IndexSlot));
+	STATS_ALLOCATED(list, (size_t)capacity * sizeof(struct IndexSlot));
+
+	/* values are distinct, so each goes in the first empty slot from its home */
+	unsigned int mask = (unsigned int)capacity - 1;
+	for (int i = 0; i < list->indexCapacity; i++)
+	{
+		struct Link* link = list->index[i].link;
+		if (link != 0 && link != TOMBSTONE)
+		{
+			unsigned int j = mixHash(HASH(link->value)) & mask;
+			while (slots[j].link != 0)
+			{
+				j = (j + 1) & mask;
+			}
+			slots[j] = list->index[i];
+		}
+	}
+
+	listFree(list, list->index, (size_t)list->indexCapacity * sizeof(struct IndexSlot));
+	list->index = slots;
+	list->indexCapacity = capacity;
+	list->indexFilled = list->indexKeys;
+}
+
+/**
+	Returns the equal-value chain entry of a link, or the entry it
+	would be inserted into (as indexProbe does).
+	param: 	list 	struct LinkedList ptr
+	param:	link 	struct Link ptr
+	pre: 	list has an equal-value table
+	ret:	entry; its link is link if it was found
+ */
+static struct EqualLinks* equalProbe(struct LinkedList* list, struct Link* link)
+{
+	uint64_t address = (uint64_t)(uintptr_t)link;
+	unsigned int mask = (unsigned int)list->equalCapacity - 1;
+	unsigned int i = mixHash((unsigned int)(address ^ (address >> 32))) & mask;
+	struct EqualLinks* reuse = 0;
+
+	while (list->equal[i].link != link && list->equal[i].link != 0)
+	{
+		if (list->equal[i].link == TOMBSTONE && reuse == 0)
+		{
+			reuse = &list->equal[i];
+		}
+		i = (i + 1) & mask;
+	}
+
+	return (list->equal[i].link == 0 && reuse != 0) ? reuse : &list->equal[i];
+}
+
+/**
+	Returns the equal-value chain entry of a link.
+	param: 	list 	struct LinkedList ptr
+	param:	link 	struct Link ptr whose value other links also hold
+ */
+static struct EqualLinks* equalFind(struct LinkedList* list, struct Link* link)
+{
+	struct EqualLinks* entry = equalProbe(list, link);
+	assert(entry->link == link);
+	return entry;
+}
+
+/**
+	Rebuilds the equal-value table with the given number of entries,
+	dropping all tombstones.
+	param: 	list 		struct LinkedList ptr
+	param:	capacity	new number of entries, a power of 2
+	pre:	capacity is larger than the number of chained links
+ */
+static void equalRehash(struct LinkedList* list, int capacity)
+{
+	struct EqualLinks* old = list->equal;
+	int oldCapacity = list->equalCapacity;
+
+	list->equal = listAlloc(list, (size_t)capacity * sizeof(struct EqualLinks));
+	memset(list->equal, 0, (size_t)capacity * sizeof(struct EqualLinks));
+	STATS_ALLOCATED(list, (size_t)capacity * sizeof(struct EqualLinks));
+	list->equalCapacity = capacity;
+	list->equalFilled = list->equalLinks;
+
+	for (int i = 0; i < oldCapacity; i++)
+	{
+		if (old[i].link != 0 && old[i].link != TOMBSTONE)
+		{
+			*equalProbe(list, old[i].link) = old[i];
+		}
+	}
+	listFree(list, old, (size_t)oldCapacity * sizeof(struct EqualLinks));
+}
+
+/**
+	Adds a link's entry to the equal-value table, growing the table
+	to keep its load factor at or below 1/2.
+	param: 	list 	struct LinkedList ptr
+	param:	link 	struct Link ptr not in the table
+	param:	next 	next link in its chain, or NULL
+	param:	prev 	previous link in its chain, or NULL
+ */
+static void equalAdd(struct LinkedList* list, struct Link* link, struct Link* next, struct Link* prev)
+{
+	if ((list->equalFilled + 1) * 2 > list->equalCapacity)
+	{
+		int capacity = (list->equalCapacity > 0) ? list->equalCapacity : INDEX_MIN_CAPACITY;
+		while ((list->equalLinks + 1) * 2 > capacity)
+		{
+			capacity *= 2;
+		}
+		equalRehash(list, capacity);
+	}
+
+	struct EqualLinks* entry = equalProbe(list, link);
+	assert(entry->link != link);
+	list->equalFilled += (entry->link == 0);
+	list->equalLinks += 1;
+	entry->link = link;
+	entry->next = next;
+	entry->prev = prev;
+}
+
+/**
+	Removes an entry from the equal-value table, leaving a tombstone,
+	or clearing the whole table once no link is left in it.
+	param: 	list 	struct LinkedList ptr
+	param:	entry 	struct EqualLinks ptr holding a link
+ */
+static void equalRemove(struct LinkedList* list, struct EqualLinks* entry)
+{
+	entry->link = TOMBSTONE;
+	list->equalLinks -= 1;
+	if (list->equalLinks == 0)
+	{
+		memset(list->equal, 0, (size_t)list->equalCapacity * sizeof(struct EqualLinks));
+		list->equalFilled = 0;
+	}
+}
+
+/**
+	Adds a link that was just linked into the list to its index,
+	growing the index to keep the load factor at or below 1/2. A
+	value already indexed is not given another slot: the link goes
+	on the front of the value's chain instead.
+	param: 	list 	struct LinkedList ptr
+	param:	link 	struct Link ptr
+	pre: 	list is hashed
+ */
+static void indexInsert(struct LinkedList* list, struct Link* link)
+{
+	if ((list->indexFilled + 1) * 2 > list->indexCapacity)
+	{
+		/* only grow if values (not tombstones) fill the table */
+		int capacity = list->indexCapacity;
+		while ((list->indexKeys + 1) * 2 > capacity)
+		{
+			capacity *= 2;
+		}
+		indexRehash(list, capacity);
+	}
+
+	struct IndexSlot* slot = indexProbe(list, link->value);
+	if (slot->link == 0 || slot->link == TOMBSTONE)
+	{
+		list->indexFilled += (slot->link == 0);
+		list->indexKeys += 1;
+		slot->link = link;
+		slot->count = 1;
+		return;
+	}
+
+	/* a repeated value; its first two links start the chain */
+	struct Link* head = slot->link;
+	if (slot->count == 1)
+	{
+		equalAdd(list, head, 0, link);
+	}
+	else
+	{
+		equalFind(list, head)->prev = link;
+	}
+	equalAdd(list, link, head, 0);
+	slot->link = link;
+	slot->count += 1;
+}
+
+/**
+	Removes a link from the index: a value's only link leaves a
+	tombstone in its slot, any other is unlinked from the value's
+	chain in O(1).
+	param: 	list 	struct LinkedList ptr
+	param:	link 	struct Link ptr
+	pre: 	list is hashed and link is in the index
+ */
+static void indexErase(struct LinkedList* list, struct Link* link)
+{
+	struct IndexSlot* slot = indexProbe(list, link->value);
+	assert(slot->link != 0 && slot->link != TOMBSTONE);
+
+	if (slot->count == 1)
+	{
+		assert(slot->link == link);
+		slot->link = TOMBSTONE;
+		list->indexKeys -= 1;
+		return;
+	}
+
+	struct EqualLinks* entry = equalFind(list, link);
+	struct Link* next = entry->next;
+	struct Link* prev = entry->prev;
+	equalRemove(list, entry);
+
+	if (prev != 0)
+	{
+		equalFind(list, prev)->next = next;
+	}
+	else
+	{
+		slot->link = next;
+	}
+	if (next != 0)
+	{
+		equalFind(list, next)->prev = prev;
+	}
+
+	/* a value held by one link needs no chain */
+	slot->count -= 1;
+	if (slot->count == 1)
+	{
+		equalRemove(list, equalFind(list, slot->link));
+	}
+}
+
+/**
+	Removes a value and all of its links from the index in one step,
+	returning the head of the value's chain; indexTakeNext then walks
+	the rest of it.
+	param: 	list 	struct LinkedList ptr
+	param:	value 	TYPE
+	pre: 	list is hashed
+	ret:	a link holding value, or NULL if no link does
+ */
+static struct Link* indexTake(struct LinkedList* list, TYPE value)
+{
+	struct IndexSlot* slot = indexProbe(list, value);
+	if (slot->link == 0 || slot->link == TOMBSTONE)
+	{
+		return 0;
+	}
+
+	struct Link* head = slot->link;
+	slot->link = TOMBSTONE;
+	list->indexKeys -= 1;
+	return head;
+}
+
+/**
+	Returns the link after one in a chain taken by indexTake,
+	dropping the link's equal-value entry. Only values held by more
+	than one link have entries, so a lone link ends its chain.
+	param: 	list 	struct LinkedList ptr
+	param:	link 	struct Link ptr returned by indexTake or indexTakeNext
+	ret:	next link holding the same value, or NULL
+ */
+static struct Link* indexTakeNext(struct LinkedList* list, struct Link* link)
+{
+	if (list->equalLinks == 0)
+	{
+		return 0;
+	}
+	struct EqualLinks* entry = equalProbe(list, link);
+	if (entry->link != link)
+	{
+		return 0;
+	}
+	struct Link* next = entry->next;
+	equalRemove(list, entry);
+	return next;
+}
+
+/**
+	Returns a link holding the given value using the index.
+	param: 	list 	struct LinkedList ptr
+	param:	value 	TYPE
+	pre: 	list is hashed
+	ret:	a link whose value is EQ to value, or NULL
+ */
+static struct Link* indexFind(struct LinkedList* list, TYPE value)
+{
+	struct Link* link = indexProbe(list, value)->link;
+	return (link != TOMBSTONE) ? link : 0;
+}
+
+/**
+	Returns the two hashes that generate a value's bloom filter bits.
+	HASH is mixed further since bloom bits need well spread low bits.
+	param:	value	TYPE
+	param:	h1		receives the first hash
+	param:	h2		receives the (odd) step between bits
+ */
+static void bloomHashes(TYPE value, unsigned int* h1, unsigned int* h2)
+{
+	unsigned int h = mixHash(HASH(value));
+
+	*h1 = h;
+	*h2 = (h * 0x9e3779b1u) | 1u;
+}
+
+/**
+	Sets a value's bits in the bloom filter.
+	param: 	list 	struct LinkedList ptr
+	param:	value 	TYPE
+	pre: 	list has a bloom filter
+ */
+static void bloomAdd(struct LinkedList* list, TYPE value)
+{
+	unsigned int h1, h2;
+	unsigned int mask = (unsigned int)list->bloomBits - 1;
+	bloomHashes(value, &h1, &h2);
+
+	for (int i = 0; i < BLOOM_HASHES; i++)
+	{
+		unsigned int bit = (h1 + (unsigned int)i * h2) & mask;
+		list->bloom[bit / 64] |= (uint64_t)1 << (bit % 64);
+	}
+	list->bloomValues += 1;
+}
+
+/**
+	Returns 0 if the value is certainly not in the list.
+	param: 	list 	struct LinkedList ptr
+	param:	value 	TYPE
+	pre: 	list has a bloom filter
+	ret:	1 if all of the value's bits are set, otherwise 0
+ */
+static int bloomMayContain(struct LinkedList* list, TYPE value)
+{
+	unsigned int h1, h2;
+	unsigned int mask = (unsigned int)list->bloomBits - 1;
+	bloomHashes(value, &h1, &h2);
+
+	for (int i = 0; i < BLOOM_HASHES; i++)
+	{
+		unsigned int bit = (h1 + (unsigned int)i * h2) & mask;
+		if ((list->bloom[bit / 64] & ((uint64_t)1 << (bit % 64))) == 0)
+		{
+			return 0;
+		}
+	}
+	return 1;
+}
+
+/**
+	Clears the bloom filter and resizes it for the given number of
+	values (at least 64 bits).
+	param: 	list 	struct LinkedList ptr
+	param:	capacity	number of values the filter is sized for
+	post:	filter is empty
+ */
+static void bloomReset(struct LinkedList* list, int capacity)
+{
+	int bits = 64;
+	while (bits < capacity * BLOOM_BITS_PER_VALUE)
+	{
+		bits *= 2;
+	}
+
+	if (bits != list->bloomBits)
+	{
+		listFree(list, list->bloom, (size_t)list->bloomBits / 8);
+		list->bloom = listAlloc(list, (size_t)bits / 8);
+		STATS_ALLOCATED(list, (size_t)bits / 8);
+		list->bloomBits = bits;
+	}
+	memset(list->bloom, 0, (size_t)bits / 8);
+	list->bloomValues = 0;
+	list->bloomStale = 0;
+	list->bloomStats.bits = bits;
+}
+
+/**
+	Rebuilds the bloom filter from the list's links if removals have
+	left too many stale bits, or if it holds more values than it was
+	sized for.
+	param: 	list 	struct LinkedList ptr
+	pre: 	list has a bloom filter
+ */
+static void bloomRefresh(struct LinkedList* list)
+{
+	int staleLimit = list->bloomValues / 4 > BLOOM_MIN_STALE ? list->bloomValues / 4 : BLOOM_MIN_STALE;
+	int overfull = list->bloomValues * BLOOM_BITS_PER_VALUE > list->bloomBits;
+
+	if (list->bloomStale > staleLimit || overfull)
+	{
+		bloomReset(list, overfull ? list->size * 2 : list->size);
+		for (struct Link* link = list->frontSentinel->next; link != list->backSentinel; link = link->next)
+		{
+			bloomAdd(list, link->value);
+		}
+		list->bloomStats.rebuilds += 1;
+	}
+}
+
+/**
+	Updates the list's lookup structures (hash index, bloom filter)
+	for a link that was just linked in.
+	param: 	list 	struct LinkedList ptr
+	param:	link 	struct Link ptr
+	pre:	list size already counts link
+ */
+static void linkAdded(struct LinkedList* list, struct Link* link)
+{
+	if (list->index != 0)
+	{
+		indexInsert(list, link);
+	}
+	if (list->bloom != 0)
+	{
+		bloomAdd(list, link->value);
+	}
+}
+
+/**
+	Updates the list's lookup structures (hash index, bloom filter)
+	for a link that is being unlinked.
+	param: 	list 	struct LinkedList ptr
+	param:	link 	struct Link ptr
+ */
+static void linkRemoved(struct LinkedList* list, struct Link* link)
+{
+	if (list->index != 0)
+	{
+		indexErase(list, link);
+	}
+	if (list->bloom != 0)
+	{
+		list->bloomStale += 1;
+	}
+}
+
+/**
+	Empties the list's lookup structures after all of its links were
+	moved elsewhere.
+	param: 	list 	struct LinkedList ptr
+	pre:	list is empty
+ */
+static void linksCleared(struct LinkedList* list)
+{
+	if (list->index != 0)
+	{
+		memset(list->index, 0, (size_t)list->indexCapacity * sizeof(struct IndexSlot));
+		list->indexFilled = 0;
+		list->indexKeys = 0;
+	}
+	if (list->equal != 0)
+	{
+		memset(list->equal, 0, (size_t)list->equalCapacity * sizeof(struct EqualLinks));
+		list->equalFilled = 0;
+		list->equalLinks = 0;
+	}
+	if (list->bloom != 0)
+	{
+		bloomReset(list, list->bloomBits / BLOOM_BITS_PER_VALUE);
+	}
+}
+
+/**
+	Returns whether the list has links that live snapshots may read.
+	Once every snapshot has been released, this also frees the
+	retired links and forgets the shared run.
+	param: 	list 	struct LinkedList ptr
+	ret:	1 if the shared run is not empty, otherwise 0
+ */
+static int snapshotShared(struct LinkedList* list)
+{
+	/* lists that never took a snapshot skip the atomic load */
+	if (list->sharedFirst == 0 && list->retiredCount == 0)
+	{
+		return 0;
+	}
+	if (__atomic_load_n(&list->snapshots, __ATOMIC_ACQUIRE) > 0)
+	{
+		return list->sharedFirst != 0;
+	}
+
+	/* no reader is left, and only this (the writer's) thread takes snapshots */
+	for (int i = 0; i < list->retiredCount; i++)
+	{
+		freeLink(list, list->retired[i]);
+	}
+	list->retiredCount = 0;
+	list->sharedFirst = 0;
+	list->sharedLast = 0;
+	return 0;
+}
+
+/**
+	Keeps a link that was unlinked while snapshots may read it until
+	they are released.
+	param: 	list 	struct LinkedList ptr
+	param:	link 	struct Link ptr, no longer in the list
+ */
+static void retireLink(struct LinkedList* list, struct Link* link)
+{
+	if (list->retiredCount == list->retiredCapacity)
+	{
+		int capacity = list->retiredCapacity > 0 ? list->retiredCapacity * 2 : 64;
+		struct Link** retired = listAlloc(list, (size_t)capacity * sizeof(struct Link*));
+		if (list->retiredCount > 0)
+		{
+			memcpy(retired, list->retired, (size_t)list->retiredCount * sizeof(struct Link*));
+		}
+		listFree(list, list->retired, (size_t)list->retiredCapacity * sizeof(struct Link*));
+		list->retired = retired;
+		list->retiredCapacity = capacity;
+	}
+	list->retired[list->retiredCount++] = link;
+}
+
+/**
+	Replaces the shared links before node with copies and retires the
+	originals, so that node becomes the first shared link and may be
+	unlinked in place (see removeLink); the links from node on stay
+	shared. Does nothing if node is outside the shared run. O(links
+	walked), and each shared link is copied at most once, so removing
+	every shared link one by one costs O(shared links) in all.
+	param: 	list 	struct LinkedList ptr
+	param:	node	a link in the list, not a sentinel
+	pre:	snapshotShared(list)
+	post:	node is the first shared link, or is not shared
+ */
+static void unshareBefore(struct LinkedList* list, struct Link* node)
+{
+	/* walking back from node meets sharedFirst first if node is in the
+	   run, sharedLast if it is after it, the front sentinel if before */
+	struct Link* link = node;
+	while (link != list->sharedFirst)
+	{
+		link = link->prev;
+		if (link == list->sharedLast || link == list->frontSentinel)
+		{
+			return;
+		}
+	}
+
+	struct Link* prev = list->sharedFirst->prev;
+	link = list->sharedFirst;
+	while (link != node)
+	{
+		struct Link* next = link->next;
+		struct Link* copy = allocLink(list);
+
+		copy->value = link->value;
+		copy->prev = prev;
+		prev->next = copy;
+		if (list->index != 0)
+		{
+			indexErase(list, link);
+			indexInsert(list, copy);
+		}
+		retireLink(list, link);
+		prev = copy;
+		link = next;
+	}
+	prev->next = node;
+	node->prev = prev;
+	list->sharedFirst = node;
+}
+
+/**
+	Replaces every shared link with a copy and retires the originals,
+	so that the caller may relink the list freely. O(shared links).
+	param: 	list 	struct LinkedList ptr
+	param:	keep	a link in the list the caller holds, or NULL
+	post:	no link in the list is read by a snapshot
+	ret:	keep, or its copy if it was shared
+ */
+static struct Link* unshare(struct LinkedList* list, struct Link* keep)
+{
+	if (!snapshotShared(list))
+	{
+		return keep;
+	}
+
+	struct Link* prev = list->sharedFirst->prev;
+	struct Link* end = list->sharedLast->next;
+	struct Link* link = list->sharedFirst;
+	while (link != end)
+	{
+		struct Link* next = link->next;
+		struct Link* copy = allocLink(list);
+
+		copy->value = link->value;
+		copy->prev = prev;
+		prev->next = copy;
+		if (list->index != 0)
+		{
+			indexErase(list, link);
+			indexInsert(list, copy);
+		}
+		retireLink(list, link);
+		if (link == keep)
+		{
+			keep = copy;
+		}
+		prev = copy;
+		link = next;
+	}
+	prev->next = end;
+	end->prev = prev;
+
+	list->sharedFirst = 0;
+	list->sharedLast = 0;
+	return keep;
+}
+
+/* FIXME: You will write this function */
+/**
+  	Allocates the list's sentinel and sets the size to 0.
+  	The sentinels' next and prev should point to eachother or NULL
+  	as appropriate.
+	param: 	list 	struct LinkedList ptr
+	param:	capacity	number of links in the first slab
+	pre: 	list is not null
+	post: 	list front and back sentinel not null
+			front sentinel next points to back
+			front sentinel prev points to null
+			back sentinel prev points to front
+			back sentinel next points to null
+			list size is 0
+			list allocates from the given pool, or from a new pool
+			whose first slab has the given capacity
+			list has an empty index if it is hashed
+			list has an empty bloom filter if it asks for one
+ */
+static void init(struct LinkedList* list, int capacity, int flags, struct LinkPool* pool) 
+{
+	/* validate list != NULL */
+	assert(list != 0);
+
+#ifdef LINKED_LIST_STATS
+	memset(&list->stats, 0, sizeof(list->stats));
+	STATS_ALLOCATED(list, sizeof(struct LinkedList) + 2 * sizeof(struct Link));
+#endif
+
+	/* share the pool, or start one with a first slab sized by the caller's hint */
+	if (pool != 0)
+	{
+		pool->refs += 1;
+		list->pool = pool;
+	}
+	else
+	{
+		list->pool = poolCreate(&list->allocator, capacity > 0 ? capacity : SLAB_DEFAULT_CAPACITY);
+		STATS_ALLOCATED(list, sizeof(struct LinkPool) + sizeof(struct Slab)
+			+ (size_t)(capacity > 0 ? capacity : SLAB_DEFAULT_CAPACITY) * sizeof(struct Link));
+	}
+
+	/* empty index, sized so that capacity links fit without rehashing */
+	list->flags = flags;
+	list->index = 0;
+	list->indexCapacity = 0;
+	list->indexFilled = 0;
+	list->indexKeys = 0;
+	list->equal = 0;
+	list->equalCapacity = 0;
+	list->equalFilled = 0;
+	list->equalLinks = 0;
+	if (flags & LINKED_LIST_HASHED)
+	{
+		list->indexCapacity = INDEX_MIN_CAPACITY;
+		while (list->indexCapacity < capacity * 2)
+		{
+			list->indexCapacity *= 2;
+		}
+		list->index = listAlloc(list, (size_t)list->indexCapacity * sizeof(struct IndexSlot));
+		memset(list->index, 0, (size_t)list->indexCapacity * sizeof(struct IndexSlot));
+		STATS_ALLOCATED(list, (size_t)list->indexCapacity * sizeof(struct IndexSlot));
+	}
+
+	/* empty bloom filter, sized for capacity values */
+	list->bloom = 0;
+	list->bloomBits = 0;
+	memset(&list->bloomStats, 0, sizeof(list->bloomStats));
+	list->probes = 0;
+
+	/* no snapshots */
+	list->sharedFirst = 0;
+	list->sharedLast = 0;
+	list->snapshots = 0;
+	list->retired = 0;
+	list->retiredCount = 0;
+	list->retiredCapacity = 0;
+	if (flags & LINKED_LIST_BLOOM)
+	{
+		bloomReset(list, capacity);
+	}
+
+	/* allocate memory for both sentinels */
+	struct Link* fSentinel = listAlloc(list, sizeof(struct Link));
+	struct Link* bSentinel = listAlloc(list, sizeof(struct Link));
+
+	/* point LL sentinel pointers to the proper memory addresses */
+	list->frontSentinel = fSentinel;
+	list->backSentinel = bSentinel;
+
+	list->frontSentinel->next = list->backSentinel;
+	list->frontSentinel->prev = NULL;
+	list->backSentinel->prev = list->frontSentinel;
+	list->backSentinel->next = NULL;
+
+	/* update sentinel and list values */
+	list->frontSentinel->value = 0;
+	list->backSentinel->value = 0;
+	list->size = 0;
+}
+
+/* FIXME: You will write this function */
+/**
+ 	Adds a new link with the given value before the given link and
+	increments the list's size.
+ 	param: 	list 	struct LinkedList ptr
+ 	param:	link 	struct Link ptr
+ 	param: 	TYPE
+	pre: 	list and link are not null
+	post: 	newLink is not null
+			newLink w/ given value is added before param link
+			list size is incremented by 1
+ */
+static void addLinkBefore(struct LinkedList* list, struct Link* link, TYPE value)
+{
+	/* assertions for validation */
+	assert(list != 0);
+	assert(link != 0);
+
+	/* initialize a new node, which will be inserted into the LL */
+	struct Link* node = allocLink(list);
+	node->value = value;
+
+	/* the new node is inserted between link and its predecessor */
+	struct Link* temp = link->prev;
+	assert(temp != 0 && temp->next == link);
+
+	/* insert the new node & update pointers of nodes within the list */
+	node->next = link;
+	temp->next = node;
+	assert(temp->next == node && node->next == link);
+
+	link->prev = node;
+	node->prev = temp;
+	assert(link->prev == node && node->prev == temp);
+
+	/* increase the LL's size by 1 */
+	list->size += 1;
+
+	/* keep the hash index and bloom filter in sync */
+	linkAdded(list, node);
+}
+
+/* FIXME: You will write this function */
+/**
+	Removes the given link from the list and
+	decrements the list's size.
+	param: 	list 	struct LinkedList ptr
+ 	param:	link 	struct Link ptr
+	pre: 	list and link are not null
+	pre:	link is not shared with a snapshot, or is the first shared
+			link and its predecessor is not shared
+	post: 	param link is removed from param list
+			link is returned to the list's free list (or retired)
+			list size is decremented by 1
+ */
+static void removeLink(struct LinkedList* list, struct Link* link)
+{
+	/* assertions for validation (list & link are not NULL */
+	assert(list != 0);
+	assert(link != 0);
+
+	/* the node before the link that will be removed */
+	struct Link* temp = link->prev;
+
+	assert(temp->next == link && link->prev == temp);
+
+	/* re-point node pointers */
+	temp->next = link->next;
+	link->next->prev = temp;
+
+	/* keep the hash index and bloom filter in sync */
+	linkRemoved(list, link);
+
+	/* recycle the removed node, unless snapshots may still read it */
+	assert(link != list->frontSentinel && link != list->backSentinel);
+	if (snapshotShared(list) && link == list->sharedFirst)
+	{
+		list->sharedFirst = (link == list->sharedLast) ? 0 : link->next;
+		list->sharedLast = (link == list->sharedLast) ? 0 : list->sharedLast;
+		retireLink(list, link);
+	}
+	else
+	{
+		freeLink(list, link);
+	}
+	list->size -= 1;
+}
+
+/**
+	Adds n new links holding the given values, in array order, before
+	the given link and increments the list's size by n. The links are
+	allocated as one block and spliced in with a single relink.
+	param: 	list 	struct LinkedList ptr
+ 	param:	link 	struct Link ptr
+ 	param: 	values 	array of n TYPE values
+ 	param:	n		number of values
+	pre: 	list, link and values are not null
+	pre:	n > 0
+	post: 	values[0] .. values[n - 1] are added before param link
+			list size is incremented by n
+ */
+static void addLinksBefore(struct LinkedList* list, struct Link* link, const TYPE* values, int n)
+{
+	assert(list != 0);
+	assert(link != 0);
+	assert(values != 0);
+	assert(n > 0);
+
+	struct Link* nodes = allocLinks(list, n);
+	struct Link* before = link->prev;
+
+	/* chain the block's links to each other */
+	for (int i = 0; i < n; i++)
+	{
+		nodes[i].value = values[i];
+		nodes[i].prev = (i == 0) ? before : &nodes[i - 1];
+		nodes[i].next = (i == n - 1) ? link : &nodes[i + 1];
+	}
+
+	/* splice the chain in between before and link */
+	before->next = &nodes[0];
+	link->prev = &nodes[n - 1];
+	list->size += n;
+
+	/* keep the hash index and bloom filter in sync */
+	for (int i = 0; i < n; i++)
+	{
+		linkAdded(list, &nodes[i]);
+	}
+}
+
+/**
+	Removes the run of n links starting at first, copying their values
+	out in the direction of travel, and returns the links to the free
+	list in one step.
+	param: 	list 	struct LinkedList ptr
+ 	param:	first 	struct Link ptr, the front-most link of the run
+ 	param: 	out 	buffer for n values, or NULL to discard them
+ 	param:	n		number of links
+ 	param:	reverse	if nonzero, out receives the values back to front
+	pre: 	list and first are not null
+	pre:	the list holds at least n links from first onwards
+	post: 	run of links is removed from param list
+			list size is decremented by n
+ */
+static void removeLinkRun(struct LinkedList* list, struct Link* first, TYPE* out, int n, int reverse)
+{
+	assert(list != 0);
+	assert(first != 0);
+	assert(n > 0 && n <= list->size);
+
+	struct Link* last = first;
+	for (int i = 0; i < n; i++)
+	{
+		assert(last != list->backSentinel);
+		if (out != 0)
+		{
+			out[reverse ? n - 1 - i : i] = last->value;
+		}
+		linkRemoved(list, last);
+		if (i < n - 1)
+		{
+			last = last->next;
+		}
+	}
+
+	/* unlink the whole run */
+	first->prev->next = last->next;
+	last->next->prev = first->prev;
+	list->size -= n;
+
+	freeLinkRun(list, first, last);
+}
+
+/**
+	Allocates a list header from the allocator and initializes it;
+	shared by linkedListCreateWithAllocator and linkedListLoad.
+	param:	capacity	expected number of links (<= 0 uses the default)
+	param:	flags		bitwise or of LINKED_LIST_* flags
+	param:	allocator	struct Allocator ptr, copied; NULL for malloc
+	ret:	list
+ */
+static struct LinkedList* createList(int capacity, int flags, const struct Allocator* allocator)
+{
+	struct Allocator source = allocator != 0 ? *allocator : allocatorMalloc();
+	assert(source.alloc != 0 && source.free != 0);
+
+	struct LinkedList* list = source.alloc(source.context, sizeof(struct LinkedList));
+	assert(list != 0);
+	list->allocator = source;
+	init(list, capacity, flags, 0);
+	return list;
+}
+
+/**
+	Allocates and initializes a list.
+	pre: 	none
+	post: 	memory allocated for new struct LinkedList ptr
+			list init (call to init func)
+	return: list
+ */
+struct LinkedList* linkedListCreate()
+{
+	return linkedListCreateWithCapacity(SLAB_DEFAULT_CAPACITY);
+}
+
+/**
+	Allocates and initializes a list whose first slab has room for
+	capacity links, so that many adds can be made before any further
+	allocation.
+	param:	capacity	expected number of links (<= 0 uses the default)
+	pre: 	none
+	post: 	memory allocated for new struct LinkedList ptr
+			list init (call to init func)
+	return: list
+ */
+struct LinkedList* linkedListCreateWithCapacity(int capacity)
+{
+	return linkedListCreateWithFlags(capacity, 0);
+}
+
+/**
+	Allocates and initializes a list with the given LINKED_LIST_*
+	flags, e.g. LINKED_LIST_HASHED to index the bag's values.
+	param:	capacity	expected number of links (<= 0 uses the default)
+	param:	flags		bitwise or of LINKED_LIST_* flags
+	pre: 	none
+	post: 	memory allocated for new struct LinkedList ptr
+			list init (call to init func)
+	return: list
+ */
+struct LinkedList* linkedListCreateWithFlags(int capacity, int flags)
+{
+	return linkedListCreateWithAllocator(capacity, flags, 0);
+}
+
+/**
+	Allocates and initializes a list whose header, sentinels, links,
+	index and bloom filter all come from the given allocator.
+	param:	capacity	expected number of links (<= 0 uses the default)
+	param:	flags		bitwise or of LINKED_LIST_* flags
+	param:	allocator	struct Allocator ptr, copied; NULL for malloc
+	pre: 	none
+	post: 	memory allocated for new struct LinkedList ptr
+			list init (call to init func)
+	return: list
+ */
+struct LinkedList* linkedListCreateWithAllocator(int capacity, int flags, const struct Allocator* allocator)
+{
+	struct LinkedList* list = 0;
+	STATS_CALL(list, LINKED_LIST_OP_CREATE);
+
+	list = createList(capacity, flags, allocator);
+	return list;
+}
+
+/**
+	Deallocates every link in the list including the sentinels,
+	and frees the list itself.
+	param:	list 	struct LinkedList ptr
+	pre: 	list is not null
+	post: 	links are returned to the pool, whose slabs are freed
+			once no other list uses them
+			memory allocated to front and back sentinel is freed
+			" " list " "
+ */
+void linkedListDestroy(struct LinkedList* list)
+{
+	assert(list != NULL);
+	assert(__atomic_load_n(&list->snapshots, __ATOMIC_ACQUIRE) == 0);
+#ifdef LINKED_LIST_STATS
+	/* the list's counters go with it, so they are kept in the totals */
+	long long start = statsNow();
+#endif
+	snapshotShared(list);
+
+	/* links live in the pool's slabs; if another list still shares
+	   the pool, hand them back as one run, else free whole slabs */
+	if (list->size > 0 && poolOf(list)->refs > 1) {
+		freeLinkRun(list, list->frontSentinel->next, list->backSentinel->prev);
+	}
+	poolRelease(list->pool);
+	listFree(list, list->index, (size_t)list->indexCapacity * sizeof(struct IndexSlot));
+	listFree(list, list->equal, (size_t)list->equalCapacity * sizeof(struct EqualLinks));
+	listFree(list, list->bloom, (size_t)list->bloomBits / 8);
+	listFree(list, list->retired, (size_t)list->retiredCapacity * sizeof(struct Link*));
+	listFree(list, list->frontSentinel, sizeof(struct Link));
+	listFree(list, list->backSentinel, sizeof(struct Link));
+#ifdef LINKED_LIST_STATS
+	statsRetire(list, start);
+#endif
+	listFree(list, list, sizeof(struct LinkedList));
+	list = NULL;
+}
+
+/* FIXME: You will write this function */
+/**
+	Adds a new link with the given value to the front of the deque.
+	param: 	deque 	struct LinkedList ptr
+	param: 	value 	TYPE
+	pre: 	deque is not null
+	post: 	link is created w/ param value stored before current first link
+			(call to addLinkBefore)
+ */
+void linkedListAddFront(struct LinkedList* deque, TYPE value)
+{
+	/* assertion for validation (deque is not NULL) */
+	assert(deque != 0);
+	STATS_CALL(deque, LINKED_LIST_OP_ADD_FRONT);
+
+	/* temp pointer that represents the first node/link (non-sentinel) */
+	struct Link* temp = deque->frontSentinel->next;
+
+	/* insert the node */
+	addLinkBefore(deque, temp, value);
+}
+
+/* FIXME: You will write this function */
+/**
+	Adds a new link with the given value to the back of the deque.
+	param: 	deque 	struct LinkedList ptr
+	param: 	value 	TYPE
+	pre: 	deque is not null
+	post: 	link is created with given value before current last link
+			(call to addLinkBefore)
+ */
+void linkedListAddBack(struct LinkedList* deque, TYPE value)
+{
+	/* assertion for validation (deque is not NULL) */
+	assert(deque != 0);
+	STATS_CALL(deque, LINKED_LIST_OP_ADD_BACK);
+
+	/* node that points to the deque's back sentinel */
+	struct Link* temp = deque->backSentinel;
+
+	/* insert the node */
+	addLinkBefore(deque, temp, value);
+}
+
+/* FIXME: You will write this function */
+/**
+	Returns the value of the link at the front of the deque.
+	param: 	deque 	struct LinkedList ptr
+	pre:	deque is not null
+	pre:	deque is not empty
+	post:	none
+	ret:	first link's value 
+ */
+TYPE linkedListFront(struct LinkedList* deque)
+{
+	/* assertions for validation (deque is not NULL & deck is not empty) */
+	assert(deque != 0);
+	STATS_CALL(deque, LINKED_LIST_OP_FRONT);
+	assert(deque->size > 0);
+
+	/* return the first node's value in the list (deque) */
+	return deque->frontSentinel->next->value;
+}
+
+/* FIXME: You will write this function */
+/**
+	Returns the value of the link at the back of the deque.
+	param: 	deque 	struct LinkedList ptr
+	pre:	deque is not null
+	pre:	deque is not empty
+	post:	none
+	ret:	last link's value 
+ */
+TYPE linkedListBack(struct LinkedList* deque)
+{
+	/* assertions for validation (deque is not NULL & deque is not empty) */
+	assert(deque != 0);
+	STATS_CALL(deque, LINKED_LIST_OP_BACK);
+	assert(deque->size > 0);
+
+	/* return the last node's value in the list (deque) */
+	return deque->backSentinel->prev->value;
+}
+
+/* FIXME: You will write this function */
+/**
+	Removes the link at the front of the deque.
+	param: 	deque 	struct LinkedList ptr
+	pre:	deque is not null
+	pre:	deque is not empty
+	post:	first link is removed and freed (call to removeLink)
+ */
+void linkedListRemoveFront(struct LinkedList* deque)
+{
+	/* assertions for validation (deque is not NULL & deque is not empty) */
+	assert(deque != 0);
+	STATS_CALL(deque, LINKED_LIST_OP_REMOVE_FRONT);
+	assert(deque->size > 0);
+
+	/* variable that points to the first node in the list (deque) */
+	struct Link* front = deque->frontSentinel->next;
+
+	/* remove the front node/link */
+	removeLink(deque, front);
+}
+
+/* FIXME: You will write this function */
+/**
+	Removes the link at the back of the deque.
+	param: 	deque 	struct LinkedList ptr
+	pre:	deque is not null
+	pre:	deque is not empty
+	post:	last link is removed and freed (call to removeLink)
+ */
+void linkedListRemoveBack(struct LinkedList* deque)
+{
+	/* assertions for validation (deque is not NULL & deque is not empty) */
+	assert(deque != 0);
+	STATS_CALL(deque, LINKED_LIST_OP_REMOVE_BACK);
+	assert(deque->size > 0);
+
+	/* point to the last (non-sentinel) node in the deque */
+	struct Link* last = deque->backSentinel->prev;
+
+	/* unlinking a shared back rewrites its predecessor's next pointer */
+	if (snapshotShared(deque) && last == deque->sharedLast)
+	{
+		unshareBefore(deque, last);
+	}
+
+	/* remove the last node/link */
+	removeLink(deque, last);
+}
+
+/**
+	Adds n values to the front of the deque in array order, so that
+	values[0] becomes the front. All n links are allocated as one block.
+	param: 	deque 	struct LinkedList ptr
+	param: 	values 	array of n TYPE values
+	param:	n		number of values
+	pre: 	deque is not null
+	pre:	values is not null if n > 0
+	post: 	values are the first n values of the deque
+ */
+void linkedListAddFrontN(struct LinkedList* deque, const TYPE* values, int n)
+{
+	assert(deque != 0);
+	STATS_CALL(deque, LINKED_LIST_OP_ADD_FRONT_N);
+	assert(n >= 0);
+
+	if (n > 0)
+	{
+		addLinksBefore(deque, deque->frontSentinel->next, values, n);
+	}
+}
+
+/**
+	Adds n values to the back of the deque in array order, as if by
+	n calls to linkedListAddBack. All n links are allocated as one block.
+	param: 	deque 	struct LinkedList ptr
+	param: 	values 	array of n TYPE values
+	param:	n		number of values
+	pre: 	deque is not null
+	pre:	values is not null if n > 0
+	post: 	values are the last n values of the deque
+ */
+void linkedListAddBackN(struct LinkedList* deque, const TYPE* values, int n)
+{
+	assert(deque != 0);
+	STATS_CALL(deque, LINKED_LIST_OP_ADD_BACK_N);
+	assert(n >= 0);
+
+	if (n > 0)
+	{
+		addLinksBefore(deque, deque->backSentinel, values, n);
+	}
+}
+
+/**
+	Removes the first n links of the list, copying their values front
+	to back into out; linkedListRemoveFrontN without the instrumentation,
+	so other API calls can use it without recording a second call.
+	param: 	deque 	struct LinkedList ptr
+	param: 	out 	buffer for n values, or NULL to discard them
+	param:	n		number of values to remove
+	pre:	0 <= n <= size
+ */
+static void removeFrontRun(struct LinkedList* deque, TYPE* out, int n)
+{
+	if (n > 0 && snapshotShared(deque))
+	{
+		/* one at a time, so shared links are retired rather than freed */
+		for (int i = 0; i < n; i++)
+		{
+			struct Link* front = deque->frontSentinel->next;
+			if (out != 0)
+			{
+				out[i] = front->value;
+			}
+			removeLink(deque, front);
+		}
+	}
+	else if (n > 0)
+	{
+		removeLinkRun(deque, deque->frontSentinel->next, out, n, 0);
+	}
+}
+
+/**
+	Removes up to n links from the front of the deque, copying their
+	values front to back into out (as n calls to linkedListFront and
+	linkedListRemoveFront would). The links are released in one pass.
+	param: 	deque 	struct LinkedList ptr
+	param: 	out 	buffer for n values, or NULL to discard them
+	param:	n		maximum number of values to remove
+	pre: 	deque is not null
+	ret:	number of values removed, min(n, size)
+ */
+int linkedListRemoveFrontN(struct LinkedList* deque, TYPE* out, int n)
+{
+	assert(deque != 0);
+	STATS_CALL(deque, LINKED_LIST_OP_REMOVE_FRONT_N);
+	assert(n >= 0);
+
+	if (n > deque->size)
+	{
+		n = deque->size;
+	}
+	removeFrontRun(deque, out, n);
+	return n;
+}
+
+/**
+	Removes up to n links from the back of the deque, copying their
+	values back to front into out (as n calls to linkedListBack and
+	linkedListRemoveBack would). The links are released in one pass.
+	param: 	deque 	struct LinkedList ptr
+	param: 	out 	buffer for n values, or NULL to discard them
+	param:	n		maximum number of values to remove
+	pre: 	deque is not null
+	ret:	number of values removed, min(n, size)
+ */
+int linkedListRemoveBackN(struct LinkedList* deque, TYPE* out, int n)
+{
+	assert(deque != 0);
+	STATS_CALL(deque, LINKED_LIST_OP_REMOVE_BACK_N);
+	assert(n >= 0);
+
+	if (n > deque->size)
+	{
+		n = deque->size;
+	}
+	if (n > 0)
+	{
+		unshare(deque, 0);
+
+		/* walk back to the front-most link of the run */
+		struct Link* first = deque->backSentinel;
+		for (int i = 0; i < n; i++)
+		{
+			first = first->prev;
+		}
+		removeLinkRun(deque, first, out, n, 1);
+	}
+	return n;
+}
+
+/**
+	Moves every link of src to the back of dst by relinking, leaving
+	src empty. The lists' pools are merged if they differ, so this is
+	O(1); keeping a hash index or bloom filter in sync adds O(size of src).
+	Lists with different allocators cannot share a pool, so src's
+	values are copied instead, in O(size of src).
+	Once their pools are merged, dst and src (and any list already
+	sharing either pool) allocate from one unsynchronized pool for
+	good: they must not be used from different threads at the same
+	time, and no slab is freed until all of them are destroyed.
+	param: 	dst 	struct LinkedList ptr
+	param: 	src 	struct LinkedList ptr
+	pre: 	dst and src are not null and are different lists
+	pre:	dst and src, and lists sharing their pools, are used by
+			the calling thread only
+	post: 	dst holds its values followed by src's values
+			src is empty
+ */
+void linkedListConcat(struct LinkedList* dst, struct LinkedList* src)
+{
+	assert(dst != 0 && src != 0);
+	STATS_CALL(dst, LINKED_LIST_OP_CONCAT);
+	assert(dst != src);
+
+	if (src->size == 0)
+	{
+		return;
+	}
+
+	/* links from another allocator cannot join dst's pool: copy the values */
+	if (!allocatorSame(&dst->allocator, &src->allocator))
+	{
+		for (struct Link* link = src->frontSentinel->next; link != src->backSentinel; link = link->next)
+		{
+			addLinkBefore(dst, dst->backSentinel, link->value);
+		}
+		removeFrontRun(src, 0, src->size);
+		return;
+	}
+
+	/* src's snapshots keep their links; dst gets copies */
+	unshare(src, 0);
+
+	/* links must come from one pool to be freed together */
+	struct LinkPool* pool = poolOf(dst);
+	if (poolOf(src) != pool)
+	{
+		poolMerge(pool, poolOf(src));
+		poolOf(src);	// src now allocates from dst's pool directly
+	}
+
+	struct Link* first = src->frontSentinel->next;
+	struct Link* last = src->backSentinel->prev;
+
+	/* detach the run from src */
+	src->frontSentinel->next = src->backSentinel;
+	src->backSentinel->prev = src->frontSentinel;
+
+	/* attach it before dst's back sentinel */
+	first->prev = dst->backSentinel->prev;
+	dst->backSentinel->prev->next = first;
+	last->next = dst->backSentinel;
+	dst->backSentinel->prev = last;
+
+	dst->size += src->size;
+	src->size = 0;
+
+	/* keep the hash indexes and bloom filters in sync */
+	linksCleared(src);
+	if (dst->index != 0 || dst->bloom != 0)
+	{
+		for (struct Link* link = first; link != dst->backSentinel; link = link->next)
+		{
+			linkAdded(dst, link);
+		}
+	}
+}
+
+/**
+	Splits the list after its first k values: the links from position k
+	to the back are moved, by relinking, to a new list that shares the
+	list's pool and flags. The split point is found by walking from
+	whichever end is closer; keeping hash indexes or bloom filters in
+	sync adds O(size of the tail).
+	The two lists share one unsynchronized pool from then on, as
+	after linkedListConcat: use them from one thread at a time. The
+	pool's slabs, including those holding links that the other list
+	has removed, stay allocated until both lists are destroyed.
+	param: 	list 	struct LinkedList ptr
+	param: 	k 		number of values the list keeps
+	pre: 	list is not null
+	pre:	0 <= k <= size
+	post: 	list holds its first k values
+	ret:	new list holding the remaining values, in order
+ */
+struct LinkedList* linkedListSplitAt(struct LinkedList* list, int k)
+{
+	assert(list != 0);
+	STATS_CALL(list, LINKED_LIST_OP_SPLIT_AT);
+	assert(k >= 0 && k <= list->size);
+
+	int moved = list->size - k;
+#ifdef LINKED_LIST_STATS
+	/* tail's stats start with its own create call */
+	long long start = statsNow();
+#endif
+	struct LinkedList* tail = listAlloc(list, sizeof(struct LinkedList));
+	tail->allocator = list->allocator;
+	init(tail, moved, list->flags, poolOf(list));
+#ifdef LINKED_LIST_STATS
+	struct StatsCall created = { &tail, LINKED_LIST_OP_CREATE, start };
+	statsRecord(&created);
+#endif
+	unshare(list, 0);
+
+	if (moved == 0)
+	{
+		return tail;
+	}
+
+	/* find the first link of the tail from the closer end */
+	struct Link* first;
+	if (k <= moved)
+	{
+		first = list->frontSentinel->next;
+		for (int i = 0; i < k; i++)
+			first = first->next;
+	}
+	else
+	{
+		first = list->backSentinel;
+		for (int i = 0; i < moved; i++)
+			first = first->prev;
+	}
+	struct Link* last = list->backSentinel->prev;
+	list->size = k;
+	tail->size = moved;
+
+	/* keep the hash indexes and bloom filters in sync */
+	if (list->index != 0 || list->bloom != 0)
+	{
+		for (struct Link* link = first; link != list->backSentinel; link = link->next)
+		{
+			linkRemoved(list, link);
+			linkAdded(tail, link);
+		}
+	}
+
+	/* detach the run from list */
+	first->prev->next = list->backSentinel;
+	list->backSentinel->prev = first->prev;
+
+	/* it becomes the whole of tail */
+	first->prev = tail->frontSentinel;
+	tail->frontSentinel->next = first;
+	last->next = tail->backSentinel;
+	tail->backSentinel->prev = last;
+	return tail;
+}
+
+/**
+	Merges two NULL-terminated chains that are sorted by LT, taking
+	from the left chain on ties so the merge is stable.
+	param:	left	chain of the earlier values
+	param:	right	chain of the later values
+	ret:	head of the merged chain
+ */
+static struct Link* mergeChains(struct Link* left, struct Link* right)
+{
+	struct Link head;
+	struct Link* tail = &head;
+
+	while (left != 0 && right != 0)
+	{
+		if (LT(right->value, left->value))
+		{
+			tail->next = right;
+			right = right->next;
+		}
+		else
+		{
+			tail->next = left;
+			left = left->next;
+		}
+		tail = tail->next;
+	}
+	tail->next = (left != 0) ? left : right;
+	return head.next;
+}
+
+/**
+	Sorts the list in place into ascending order by LT with a stable,
+	bottom-up merge sort that relinks the existing links. Links are
+	taken front to back and merged into sorted chains of 1, 2, 4, ...
+	links held in a fixed array of bins (bin i holds 2^i links), so
+	recently touched links are merged while still in cache. Only the
+	next pointers are used while merging; prev pointers and the
+	sentinels are fixed up in one final pass. No memory is allocated
+	and the sort is O(n log n).
+	param: 	list 	struct LinkedList ptr
+	pre: 	list is not null
+	post: 	values are in ascending order; equal values keep their
+			relative order
+ */
+void linkedListSort(struct LinkedList* list)
+{
+	assert(list != 0);
+	STATS_CALL(list, LINKED_LIST_OP_SORT);
+
+	if (list->size < 2)
+	{
+		return;
+	}
+	unshare(list, 0);
+
+	/* enough bins for 2^(bits in size) links */
+	struct Link* bins[sizeof(int) * 8 + 1] = { 0 };
+	int maxBin = 0;
+
+	/* detach the links as a NULL-terminated chain */
+	struct Link* link = list->frontSentinel->next;
+	list->backSentinel->prev->next = 0;
+
+	while (link != 0)
+	{
+		struct Link* carry = link;
+		link = link->next;
+		carry->next = 0;
+
+		/* like binary addition: carry merges up while bins are full;
+		   bins hold earlier links, so they go on the left */
+		int i = 0;
+		while (bins[i] != 0)
+		{
+			carry = mergeChains(bins[i], carry);
+			bins[i] = 0;
+			i++;
+		}
+		bins[i] = carry;
+		if (i > maxBin)
+		{
+			maxBin = i;
+		}
+	}
+
+	/* merge what remains, higher bins holding earlier links */
+	struct Link* head = 0;
+	for (int i = 0; i <= maxBin; i++)
+	{
+		if (bins[i] != 0)
+		{
+			head = (head == 0) ? bins[i] : mergeChains(bins[i], head);
+		}
+	}
+
+	/* restore prev pointers and reattach the sentinels */
+	struct Link* prev = list->frontSentinel;
+	for (link = head; link != 0; link = link->next)
+	{
+		prev->next = link;
+		link->prev = prev;
+		prev = link;
+	}
+	prev->next = list->backSentinel;
+	list->backSentinel->prev = prev;
+}
+
+/* FIXME: You will write this function */
+/**
+	Returns 1 if the deque is empty and 0 otherwise.
+	param:	deque	struct LinkedList ptr
+	pre:	deque is not null
+	post:	none
+	ret:	1 if its size is 0 (empty), otherwise 0 (not empty)
+ */
+int linkedListIsEmpty(struct LinkedList* deque)
+{
+	/* validate the deque is not NULL */
+	assert(deque != 0);
+	STATS_CALL(deque, LINKED_LIST_OP_IS_EMPTY);
+
+	/* deque is empty */
+	if (deque->frontSentinel->next == deque->backSentinel && deque->backSentinel->prev == deque->frontSentinel)
+	{
+		return 1;
+	}
+
+	/* deque is NOT empty */
+	else
+	{
+		return 0;
+	}
+}
+
+/**
+	Writes the decimal text of an integer without going through printf.
+	param:	p		destination with room for PRINT_VALUE_MAX chars
+	param:	value	integer to format
+	ret:	number of chars written (not NUL terminated)
+ */
+static int formatInteger(char* p, long long value)
+{
+	char digits[24];
+	int n = 0;
+	int len = 0;
+
+	/* work with the negative magnitude so LLONG_MIN does not overflow */
+	long long v = value < 0 ? value : -value;
+	do
+	{
+		digits[n++] = (char)('0' - (v % 10));
+		v /= 10;
+	} while (v != 0);
+
+	if (value < 0)
+	{
+		p[len++] = '-';
+	}
+	while (n > 0)
+	{
+		p[len++] = digits[--n];
+	}
+	return len;
+}
+
+/**
+	Produces the same text as linkedListPrint into the print buffer,
+	formatting each value with FORMAT_VALUE.
+	param:	deque	struct LinkedList ptr
+	param:	pb		struct PrintBuffer ptr
+ */
+static void printValues(struct LinkedList* deque, struct PrintBuffer* pb)
+{
+	static const char header[] = "Printing the deque's list of values...\n";
+	static const char empty[] = "Deque's list is empty...\n";
+
+	if (deque->size == 0)
+	{
+		printBufferPut(pb, empty, sizeof(empty) - 1);
+		return;
+	}
+
+	printBufferPut(pb, header, sizeof(header) - 1);
+	for (struct Link* link = deque->frontSentinel->next; link != deque->backSentinel; link = link->next)
+	{
+		char text[PRINT_VALUE_MAX + 1];
+		int len = FORMAT_VALUE(text, link->value);
+		text[len++] = ' ';
+		printBufferPut(pb, text, (size_t)len);
+	}
+	printBufferPut(pb, "\n", 1);
+}
+
+/* FIXME: You will write this function */
+/**
+	Prints the values of the links in the deque from front to back.
+	param:	deque	struct LinkedList ptr
+	pre:	deque is not null
+	post:	none
+	ret:	outputs to the console the values of the links from front 
+			to back; if empty, prints msg that is empty
+ */
+void linkedListPrint(struct LinkedList* deque)
+{
+	/* assertion to validate the deque is not NULL */
+	assert(deque != 0);
+	STATS_CALL(deque, LINKED_LIST_OP_PRINT);
+
+	/* list is NOT empty */
+	if (deque->size > 0)
+	{
+		/* point to the frontSentinel & iterate through the list while printing node values */
+		struct Link* link = deque->frontSentinel->next;
+
+		printf("Printing the deque's list of values...\n");
+		while (link != deque->backSentinel)
+		{
+			printf(FORMAT_SPECIFIER " ", link->value);
+			link = link->next;
+		}
+		printf("\n");
+	}
+
+	/* list is empty */
+	else
+	{
+		printf("Deque's list is empty...\n");
+	}
+}
+
+/**
+	Prints the deque as linkedListPrint does, but to the given FILE,
+	formatting values without printf and writing the text in blocks
+	of PRINT_BUFFER_SIZE chars.
+	param:	deque	struct LinkedList ptr
+	param:	out		FILE to write to
+	pre:	deque and out are not null
+	post:	text is written to out
+	ret:	0 on success, -1 if a write to out failed
+ */
+int linkedListPrintFile(struct LinkedList* deque, FILE* out)
+{
+	assert(deque != 0);
+	STATS_CALL(deque, LINKED_LIST_OP_PRINT);
+	assert(out != 0);
+
+	char* data = malloc(PRINT_BUFFER_SIZE);
+	assert(data != 0);
+
+	struct PrintBuffer pb = { out, data, PRINT_BUFFER_SIZE, 0, 0, 0 };
+	printValues(deque, &pb);
+	printBufferFlush(&pb);
+	free(data);
+	return (pb.failed || ferror(out)) ? -1 : 0;
+}
+
+/**
+	Formats the deque as linkedListPrint does into a caller's buffer.
+	Like snprintf, the text is truncated to fit and NUL terminated.
+	param:	deque	struct LinkedList ptr
+	param:	buffer	destination (may be NULL if size is 0)
+	param:	size	size of buffer in chars
+	pre:	deque is not null
+	ret:	length of the full text, excluding the NUL; the text was
+			truncated if this is >= size
+ */
+size_t linkedListPrintBuffer(struct LinkedList* deque, char* buffer, size_t size)
+{
+	assert(deque != 0);
+	STATS_CALL(deque, LINKED_LIST_OP_PRINT);
+	assert(buffer != 0 || size == 0);
+
+	if (size == 0)
+	{
+		char none;
+		struct PrintBuffer pb = { 0, &none, 0, 0, 0, 0 };
+		printValues(deque, &pb);
+		return pb.total;
+	}
+
+	struct PrintBuffer pb = { 0, buffer, size - 1, 0, 0, 0 };
+	printValues(deque, &pb);
+	buffer[pb.used] = '\0';
+	return pb.total;
+}
+
+/* FIXME: You will write this function */
+/**
+	Adds a link with the given value to the bag.
+	param:	bag		struct LinkedList ptr
+	param: 	value 	TYPE
+	pre: 	bag is not null
+	post: 	link is created w/ given value before current first link
+			(call to addLinkBefore)
+			Note that bag doesn't specify where new link should be added;
+			can be anywhere in bag according to its ADT.
+ */
+void linkedListAdd(struct LinkedList* bag, TYPE value)
+{
+	/* assertion to validate the bag is not NULL */
+	assert(bag != 0);
+	STATS_CALL(bag, LINKED_LIST_OP_ADD);
+
+	/* insert the new node (link) at the beginning of the bag's linked list */
+	addLinkBefore(bag, bag->frontSentinel->next, value);
+}
+
+/**
+	Returns a link in the bag holding the given value, using the
+	hash index when the bag has one and a front-to-back scan otherwise.
+	param:	bag		struct LinkedList ptr
+	param: 	value 	TYPE
+	pre: 	bag is not null
+	ret:	first link found whose value is EQ to value, or NULL
+ */
+static struct Link* findLink(struct LinkedList* bag, TYPE value)
+{
+	assert(bag != 0);
+
+	/* the bloom filter answers most misses without a traversal */
+	if (bag->bloom != 0)
+	{
+		bloomRefresh(bag);
+		bag->bloomStats.queries += 1;
+		if (!bloomMayContain(bag, value))
+		{
+			bag->bloomStats.rejected += 1;
+			return 0;
+		}
+	}
+
+	struct Link* node = 0;
+	if (bag->index != 0)
+	{
+		node = indexFind(bag, value);
+	}
+	else
+	{
+		/* iterate through the linked list's nodes (links) to search for a specific value */
+		long probes = 0;
+		for (node = bag->frontSentinel->next; node != bag->backSentinel; node = node->next)
+		{
+			probes++;
+			if (EQ(node->value, value))
+			{
+				break;
+			}
+		}
+		bag->probes += probes;
+		STATS_SCAN(bag, probes);
+		if (node == bag->backSentinel)
+		{
+			node = 0;
+		}
+	}
+
+	if (bag->bloom != 0 && node == 0)
+	{
+		bag->bloomStats.falsePositives += 1;
+	}
+	return node;
 }
 
-/* FIXME: You will write this function */
 /**
-	Removes the link at the back of the deque.
-	param: 	deque 	struct LinkedList ptr
-	pre:	deque is not null
-	pre:	deque is not empty
-	post:	last link is removed and freed (call to removeLink)
+	Moves a found link toward the front of a self-organizing bag:
+	all the way (LINKED_LIST_MOVE_TO_FRONT) or past its predecessor
+	(LINKED_LIST_TRANSPOSE). Only the link's pointers change, so
+	the hash index and bloom filter stay valid.
+	param:	bag		struct LinkedList ptr
+	param: 	link 	struct Link ptr in bag
  */
-void linkedListRemoveBack(struct LinkedList* deque)
+static void promoteLink(struct LinkedList* bag, struct Link* link)
 {
-	/* assertions for validation (deque is not NULL & deque is not empty) */
-	assert(deque != 0);
-	assert(deque->size > 0);
+	struct Link* before;
+	if (bag->flags & LINKED_LIST_MOVE_TO_FRONT)
+	{
+		before = bag->frontSentinel->next;
+	}
+	else if (bag->flags & LINKED_LIST_TRANSPOSE)
+	{
+		before = link->prev;
+	}
+	else
+	{
+		return;
+	}
 
-	/* point to the last (non-sentinel) node in the deque */
-	struct Link* last = deque->backSentinel->prev;
+	if (before == link || before == bag->frontSentinel)
+	{
+		return;
+	}
 
-	/* remove the last node/link */
-	removeLink(deque, last);
+	/* unlink, then relink in front of before */
+	link->prev->next = link->next;
+	link->next->prev = link->prev;
+	link->next = before;
+	link->prev = before->prev;
+	before->prev->next = link;
+	before->prev = link;
 }
 
 /* FIXME: You will write this function */
 /**
-	Returns 1 if the deque is empty and 0 otherwise.
-	param:	deque	struct LinkedList ptr
-	pre:	deque is not null
-	post:	none
-	ret:	1 if its size is 0 (empty), otherwise 0 (not empty)
+	Returns 1 if a link with the value is in the bag and 0 otherwise.
+	param:	bag		struct LinkedList ptr
+	param: 	value 	TYPE
+	pre: 	bag is not null
+	post:	a self-organizing bag has moved the found link toward its front
+	ret:	1 if link with given value found; otherwise, 0
  */
-int linkedListIsEmpty(struct LinkedList* deque)
+int linkedListContains(struct LinkedList* bag, TYPE value)
 {
-	/* validate the deque is not NULL */
-	assert(deque != 0);
+	/* assertion to validate the bag is not NULL */
+	assert(bag != 0);
+	STATS_CALL(bag, LINKED_LIST_OP_CONTAINS);
 
-	/* deque is empty */
-	if (deque->frontSentinel->next == deque->backSentinel && deque->backSentinel->prev == deque->frontSentinel)
+	struct Link* node = findLink(bag, value);
+	if (node == 0)
 	{
-		return 1;
+		return 0;
 	}
-
-	/* deque is NOT empty */
-	else
+	if (bag->flags & (LINKED_LIST_MOVE_TO_FRONT | LINKED_LIST_TRANSPOSE))
 	{
-		return 0;
+		promoteLink(bag, unshare(bag, node));
 	}
+	return 1;
 }
 
 /* FIXME: You will write this function */
 /**
-	Prints the values of the links in the deque from front to back.
-	param:	deque	struct LinkedList ptr
-	pre:	deque is not null
-	post:	none
-	ret:	outputs to the console the values of the links from front 
-			to back; if empty, prints msg that is empty
+	Removes the first occurrence of a link with the given value.
+	For a hashed bag, any one occurrence is removed.
+	param:	bag		struct LinkedList ptr
+	param: 	value 	TYPE
+	pre: 	bag is not null
+	post:	if link with given value found, link is removed
+			(call to removeLink)
  */
-void linkedListPrint(struct LinkedList* deque)
+void linkedListRemove(struct LinkedList* bag, TYPE value)
 {
-	/* assertion to validate the deque is not NULL */
-	assert(deque != 0);
+	/* assert to validate the bag is not NULL */
+	assert(bag != 0);
+	STATS_CALL(bag, LINKED_LIST_OP_REMOVE);
 
-	/* list is NOT empty */
-	if (!linkedListIsEmpty(deque))
+	/* find the node/link with the searched-for value in a single pass */
+	struct Link* node = findLink(bag, value);
+	if (node != 0)
 	{
-		/* point to the frontSentinel & iterate through the list while printing node values */
-		struct Link* link = deque->frontSentinel->next;
-
-		printf("Printing the deque's list of values...\n");
-		while (link != deque->backSentinel)
+		/* only the first shared link can be unlinked in place */
+		if (snapshotShared(bag))
 		{
-			printf("%d ", link->value);
-			link = link->next;
+			unshareBefore(bag, node);
 		}
-		printf("\n");
+		removeLink(bag, node);
 	}
+}
 
-	/* list is empty */
+/**
+	Unlinks a link and appends it to a chain of removed links (linked
+	through next), to be freed in one step. The caller keeps the hash
+	index and bloom filter in sync.
+	param:	bag		struct LinkedList ptr
+	param: 	link 	struct Link ptr in bag
+	param:	first	first link of the removed chain, NULL if empty
+	param:	last	last link of the removed chain
+	post:	link is at the end of the chain; size is decremented by 1
+ */
+static void unlinkToChain(struct LinkedList* bag, struct Link* link, struct Link** first, struct Link** last)
+{
+	link->prev->next = link->next;
+	link->next->prev = link->prev;
+	bag->size -= 1;
+
+	if (*first == 0)
+	{
+		*first = link;
+	}
 	else
 	{
-		printf("Deque's list is empty...\n");
+		(*last)->next = link;
 	}
+	*last = link;
 }
 
-/* FIXME: You will write this function */
 /**
-	Adds a link with the given value to the bag.
+	Removes every link whose value is EQ to the given value. A hashed
+	bag takes the value out of its index in one step and walks only
+	the value's chain of links; otherwise the bag is traversed once.
+	The removed links are returned to the free list together.
 	param:	bag		struct LinkedList ptr
 	param: 	value 	TYPE
 	pre: 	bag is not null
-	post: 	link is created w/ given value before current first link
-			(call to addLinkBefore)
-			Note that bag doesn't specify where new link should be added;
-			can be anywhere in bag according to its ADT.
+	post:	no link in the bag holds value
+	ret:	number of links removed
  */
-void linkedListAdd(struct LinkedList* bag, TYPE value)
+int linkedListRemoveAll(struct LinkedList* bag, TYPE value)
 {
-	/* assertion to validate the bag is not NULL */
 	assert(bag != 0);
+	STATS_CALL(bag, LINKED_LIST_OP_REMOVE_ALL);
 
-	/* insert the new node (link) at the beginning of the bag's linked list */
-	addLinkBefore(bag, bag->frontSentinel->next, value);
+	struct Link* first = 0;
+	struct Link* last = 0;
+	int removed = 0;
+
+	if (bag->bloom != 0 && !bloomMayContain(bag, value))
+	{
+		return 0;
+	}
+	unshare(bag, 0);
+
+	if (bag->index != 0)
+	{
+		for (struct Link* link = indexTake(bag, value); link != 0; )
+		{
+			struct Link* next = indexTakeNext(bag, link);
+			unlinkToChain(bag, link, &first, &last);
+			removed++;
+			link = next;
+		}
+		if (bag->bloom != 0)
+		{
+			bag->bloomStale += removed;
+		}
+	}
+	else
+	{
+		struct Link* link = bag->frontSentinel->next;
+		while (link != bag->backSentinel)
+		{
+			struct Link* next = link->next;
+			if (EQ(link->value, value))
+			{
+				linkRemoved(bag, link);
+				unlinkToChain(bag, link, &first, &last);
+				removed++;
+			}
+			link = next;
+		}
+	}
+
+	if (first != 0)
+	{
+		freeLinkRun(bag, first, last);
+	}
+	return removed;
 }
 
-/* FIXME: You will write this function */
 /**
-	Returns 1 if a link with the value is in the bag and 0 otherwise.
-	param:	bag		struct LinkedList ptr
-	param: 	value 	TYPE
-	pre: 	bag is not null
-	post:	none
-	ret:	1 if link with given value found; otherwise, 0
+	Removes every link whose value satisfies the predicate, in one
+	front-to-back traversal. The removed links are returned to the
+	free list together.
+	param:	bag			struct LinkedList ptr
+	param: 	predicate 	returns nonzero for values to remove
+	param:	ctx			passed through to predicate
+	pre: 	bag and predicate are not null
+	pre:	predicate does not modify the bag
+	ret:	number of links removed
  */
-int linkedListContains(struct LinkedList* bag, TYPE value)
+int linkedListRemoveIf(struct LinkedList* bag, int (*predicate)(TYPE value, void* ctx), void* ctx)
 {
-	/* assertion to validate the bag is not NULL */
 	assert(bag != 0);
+	STATS_CALL(bag, LINKED_LIST_OP_REMOVE_IF);
+	assert(predicate != 0);
+	unshare(bag, 0);
 
-	/* point to the a node within the bag/linkedlist */
-	struct Link* node = bag->frontSentinel->next;
+	struct Link* first = 0;
+	struct Link* last = 0;
+	int removed = 0;
 
-	/* iterate through the linked list's nodes (links) to search for a specific value */
-	while (node->next != 0 && node->next != bag->backSentinel)
+	struct Link* link = bag->frontSentinel->next;
+	while (link != bag->backSentinel)
 	{
-		/* node/link value equals the searched-for value */
-		if (node->value == value)
+		struct Link* next = link->next;
+		if (predicate(link->value, ctx))
 		{
-			return 1;
+			linkRemoved(bag, link);
+			unlinkToChain(bag, link, &first, &last);
+			removed++;
 		}
+		link = next;
+	}
 
-		/* update the node's value to the next node */
-		node = node->next;
+	if (first != 0)
+	{
+		freeLinkRun(bag, first, last);
 	}
-	
-	/* value is not in the linked list */
-	return 0;
+	return removed;
 }
 
-/* FIXME: You will write this function */
 /**
-	Removes the first occurrence of a link with the given value.
+	Writes the list to a binary image file: a struct ListImage header
+	followed by the values from front to back.
+	param:	list	struct LinkedList ptr
+	param:	path	file to create or overwrite
+	pre: 	list and path are not null
+	post:	file holds the list's image on success
+	ret:	0 on success, -1 if the file could not be written
+ */
+int linkedListSave(struct LinkedList* list, const char* path)
+{
+	assert(list != 0);
+	STATS_CALL(list, LINKED_LIST_OP_SAVE);
+	assert(path != 0);
+
+	FILE* file = fopen(path, "wb");
+	if (file == 0)
+	{
+		return -1;
+	}
+
+	struct ListImage header = { IMAGE_MAGIC, IMAGE_VERSION, sizeof(TYPE), 0, (uint64_t)list->size };
+	int ok = fwrite(&header, sizeof(header), 1, file) == 1;
+
+	/* copy values into a buffer so each write moves a block of them */
+	TYPE buffer[IMAGE_WRITE_VALUES];
+	int buffered = 0;
+	for (struct Link* link = list->frontSentinel->next; ok && link != list->backSentinel; link = link->next)
+	{
+		buffer[buffered++] = link->value;
+		if (buffered == IMAGE_WRITE_VALUES)
+		{
+			ok = fwrite(buffer, sizeof(TYPE), buffered, file) == (size_t)buffered;
+			buffered = 0;
+		}
+	}
+	if (ok && buffered > 0)
+	{
+		ok = fwrite(buffer, sizeof(TYPE), buffered, file) == (size_t)buffered;
+	}
+
+	if (fclose(file) != 0)
+	{
+		ok = 0;
+	}
+	return ok ? 0 : -1;
+}
+
+/**
+	Creates a list from a binary image written by linkedListSave. The
+	file is mapped rather than read, and its values are added with a
+	single bulk allocation (call to addLinksBefore).
+	param:	path	image file
+	pre: 	path is not null
+	ret:	new list holding the image's values front to back, or NULL
+			if the file cannot be mapped, is not a valid image for
+			this build's TYPE, or is not exactly as long as its
+			header says
+ */
+struct LinkedList* linkedListLoad(const char* path)
+{
+	assert(path != 0);
+	struct LinkedList* list = 0;
+	STATS_CALL(list, LINKED_LIST_OP_LOAD);
+
+	int fd = open(path, O_RDONLY);
+	if (fd < 0)
+	{
+		return 0;
+	}
+
+	struct stat st;
+	if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(struct ListImage))
+	{
+		close(fd);
+		return 0;
+	}
+
+	void* map = mmap(0, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (map == MAP_FAILED)
+	{
+		return 0;
+	}
+
+	/* validate the header against this build; the values must fill the
+	   rest of the file exactly, so a truncated or padded file is rejected */
+	const struct ListImage* header = map;
+	if (header->magic == IMAGE_MAGIC && header->version == IMAGE_VERSION
+		&& header->valueSize == sizeof(TYPE) && header->count <= INT32_MAX
+		&& header->count * sizeof(TYPE) == (uint64_t)st.st_size - sizeof(struct ListImage))
+	{
+		int count = (int)header->count;
+		const TYPE* values = (const TYPE*)(header + 1);
+
+		list = createList(count, 0, 0);
+		posix_madvise(map, (size_t)st.st_size, POSIX_MADV_SEQUENTIAL);
+		if (count > 0)
+		{
+			addLinksBefore(list, list->backSentinel, values, count);
+		}
+	}
+
+	munmap(map, (size_t)st.st_size);
+	return list;
+}
+
+/**
+	Reports how well the bag's bloom filter is rejecting lookups of
+	absent values.
+	param:	bag		struct LinkedList ptr
+	param:	stats	receives the counters since the bag was created
+	pre: 	bag and stats are not null
+	post:	stats is all zero if the bag has no bloom filter
+ */
+void linkedListBloomStats(struct LinkedList* bag, struct LinkedListBloomStats* stats)
+{
+	assert(bag != 0);
+	assert(stats != 0);
+
+	*stats = bag->bloomStats;
+	long misses = stats->rejected + stats->falsePositives;
+	stats->falsePositiveRate = (misses > 0) ? (double)stats->falsePositives / misses : 0.0;
+}
+
+/**
+	Returns the number of links visited by the bag's lookup scans
+	(linkedListContains/linkedListRemove) since it was created.
+	Lookups answered by the hash index or bloom filter add nothing.
 	param:	bag		struct LinkedList ptr
-	param: 	value 	TYPE
 	pre: 	bag is not null
-	post:	if link with given value found, link is removed
-			(call to removeLink)
+	ret:	total links compared against a searched-for value
  */
-void linkedListRemove(struct LinkedList* bag, TYPE value)
+long linkedListProbeCount(struct LinkedList* bag)
 {
-	/* assert to validate the bag is not NULL */
 	assert(bag != 0);
+	return bag->probes;
+}
+
+/**
+	Returns a read-only view of the list's current values in O(1).
+	The view stays valid while the list's owner keeps changing the
+	list: links removed from now on are retired instead of reused,
+	and links whose next pointer would be rewritten are copied first
+	(see the overview). The snapshot may be read and released from
+	any thread.
+	param:	list	struct LinkedList ptr
+	pre: 	list is not null
+	pre:	called by the list's writer (not concurrently with changes)
+	ret:	snapshot; release it with linkedListSnapshotRelease
+ */
+struct LinkedListSnapshot* linkedListSnapshot(struct LinkedList* list)
+{
+	assert(list != 0);
+	STATS_CALL(list, LINKED_LIST_OP_SNAPSHOT);
 
-	/* bag contains the specific value */
-	if (linkedListContains(bag, value))
+	struct LinkedListSnapshot* snapshot = malloc(sizeof(struct LinkedListSnapshot));
+	assert(snapshot != 0);
+
+	/* drop any leftovers of released snapshots, then share every link */
+	snapshotShared(list);
+	snapshot->list = list;
+	snapshot->first = list->frontSentinel->next;
+	snapshot->size = list->size;
+	if (list->size > 0)
 	{
-		/* point to the frontSentinel */
-		struct Link* node = bag->frontSentinel->next;
+		list->sharedFirst = list->frontSentinel->next;
+		list->sharedLast = list->backSentinel->prev;
+	}
+	__atomic_add_fetch(&list->snapshots, 1, __ATOMIC_RELAXED);
+	return snapshot;
+}
+
+/**
+	Returns the number of values in the snapshot.
+	param:	snapshot	struct LinkedListSnapshot ptr
+	pre: 	snapshot is not null
+ */
+int linkedListSnapshotSize(struct LinkedListSnapshot* snapshot)
+{
+	assert(snapshot != 0);
+	return snapshot->size;
+}
 
-		/* flag to end the below loop (and this function) is triggered */
-		int nodeFound = 0;		// initial value of 0 == false
+/**
+	Calls visit on each of the snapshot's values, front to back,
+	without taking any lock.
+	param:	snapshot	struct LinkedListSnapshot ptr
+	param:	visit		called with each value and ctx
+	param:	ctx			passed through to visit
+	pre: 	snapshot and visit are not null
+ */
+void linkedListSnapshotForEach(struct LinkedListSnapshot* snapshot, void (*visit)(TYPE value, void* ctx), void* ctx)
+{
+	assert(snapshot != 0);
+	assert(visit != 0);
 
-		/* find the node/link with the searched-for value (terminates this loop and function when the value is found) */
-		while (nodeFound == 0 && (node->next != 0 && node->next != bag->backSentinel))
+	/* the next pointer of the last link may be changing; never read it */
+	struct Link* link = snapshot->first;
+	for (int i = 0; i < snapshot->size; i++)
+	{
+		visit(link->value, ctx);
+		if (i < snapshot->size - 1)
 		{
-			/* node/link contains the searched-for value */
-			if (node->value == value)
-			{
-				/* remove the node/link */
-				removeLink(bag, node);
+			link = link->next;
+		}
+	}
+}
 
-				/* trigger the nodeFound flag to terminate this loop & function */
-				nodeFound = 1;
-			}
-			
-			node = node->next;
+/**
+	Releases a snapshot. Its retired links are freed by the list's
+	writer once no snapshot of the list is left.
+	param:	snapshot	struct LinkedListSnapshot ptr
+	pre: 	snapshot is not null
+	post:	snapshot is freed
+ */
+void linkedListSnapshotRelease(struct LinkedListSnapshot* snapshot)
+{
+	assert(snapshot != 0);
+
+	/* release: the writer must see every read of the links done first */
+	__atomic_sub_fetch(&snapshot->list->snapshots, 1, __ATOMIC_RELEASE);
+	free(snapshot);
+}
+
+#ifdef LINKED_LIST_STATS
+/**
+	Copies the list's instrumentation counters.
+	param:	list	struct LinkedList ptr
+	param:	stats	receives the counters since the list was created
+	pre: 	list and stats are not null
+ */
+void linkedListStats(struct LinkedList* list, struct LinkedListStats* stats)
+{
+	assert(list != 0);
+	assert(stats != 0);
+	*stats = list->stats;
+}
+
+/**
+	Copies the counters of every list destroyed so far, summed; the
+	only record of their create and destroy calls. Safe to call while
+	other threads destroy lists: the copy includes each list's
+	counters wholly or not at all.
+	param:	stats	receives the summed counters
+	pre: 	stats is not null
+	post:	peakSize and longestScan are the largest of any one list
+ */
+void linkedListStatsDestroyed(struct LinkedListStats* stats)
+{
+	assert(stats != 0);
+	statsLockDestroyed();
+	*stats = destroyedStats;
+	statsUnlockDestroyed();
+}
+
+/**
+	Prints one histogram's nonempty buckets as "<upper bound>:count".
+	param:	out			FILE to write to
+	param:	buckets		LINKED_LIST_HISTOGRAM_BUCKETS counts
+ */
+static void statsDumpHistogram(FILE* out, const long* buckets)
+{
+	for (int i = 0; i < LINKED_LIST_HISTOGRAM_BUCKETS; i++)
+	{
+		if (buckets[i] != 0)
+		{
+			fprintf(out, " <%lld:%ld", 2LL << i, buckets[i]);
+		}
+	}
+	fprintf(out, "\n");
+}
+
+/**
+	Prints the list's instrumentation counters: peak size, bytes
+	allocated, then calls, mean latency and latency histogram (ns)
+	for each operation that was called, then bag scan lengths.
+	param:	list	struct LinkedList ptr
+	param:	out		FILE to write to
+	pre: 	list and out are not null
+ */
+void linkedListStatsDump(struct LinkedList* list, FILE* out)
+{
+	assert(list != 0);
+	assert(out != 0);
+	const struct LinkedListStats* stats = &list->stats;
+
+	fprintf(out, "size %d, peak size %d, %ld bytes allocated\n",
+		list->size, stats->peakSize, stats->bytesAllocated);
+	fprintf(out, "%-14s %10s %10s  latency ns histogram\n", "op", "calls", "mean ns");
+	for (int op = 0; op < LINKED_LIST_OPS; op++)
+	{
+		if (stats->calls[op] != 0)
+		{
+			fprintf(out, "%-14s %10ld %10.0f ", statsOpNames[op], stats->calls[op],
+				(double)stats->totalNs[op] / stats->calls[op]);
+			statsDumpHistogram(out, stats->latency[op]);
 		}
 	}
+	if (stats->scans != 0)
+	{
+		fprintf(out, "%ld scans, mean %.1f links, longest %ld; links histogram",
+			stats->scans, (double)stats->scannedLinks / stats->scans, stats->longestScan);
+		statsDumpHistogram(out, stats->scanLength);
+	}
 }
+#endif
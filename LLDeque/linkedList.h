@@ -1,6 +1,9 @@
 #ifndef LINKED_LIST_H
 #define LINKED_LIST_H
 
+#include <stdio.h>
+#include "../allocator.h"
+
 #ifndef TYPE
 #define TYPE int
 #endif
@@ -13,9 +16,85 @@
 #define EQ(A, B) ((A) == (B))
 #endif
 
+/* must agree with EQ: EQ(A, B) implies HASH(A) == HASH(B); the hash index and
+   bloom filter mix it further, so its low bits need not be well spread */
+#ifndef HASH
+#define HASH(A) ((unsigned int)(A) * 2654435761u)
+#endif
+
+/* flags for linkedListCreateWithFlags */
+#define LINKED_LIST_HASHED 0x1		// index values so bag lookups are expected O(1)
+#define LINKED_LIST_BLOOM 0x2		// bloom filter so most lookups of absent values skip the scan
+#define LINKED_LIST_MOVE_TO_FRONT 0x4	// contains moves the found link to the front
+#define LINKED_LIST_TRANSPOSE 0x8		// contains swaps the found link with its predecessor
+
+// Bloom filter counters reported by linkedListBloomStats
+struct LinkedListBloomStats
+{
+	long queries;				// lookups through linkedListContains/linkedListRemove
+	long rejected;				// lookups the filter answered "absent"
+	long falsePositives;		// lookups the filter passed that found nothing
+	double falsePositiveRate;	// falsePositives / (rejected + falsePositives)
+	int rebuilds;				// times the filter was rebuilt from the links
+	int bits;					// current size of the filter
+};
+
+#ifdef LINKED_LIST_STATS
+// Operations counted by the instrumented build (-DLINKED_LIST_STATS)
+enum LinkedListOp
+{
+	LINKED_LIST_OP_CREATE,		// every linkedListCreate* function, and the tail of linkedListSplitAt
+	LINKED_LIST_OP_DESTROY,
+	LINKED_LIST_OP_IS_EMPTY,
+	LINKED_LIST_OP_ADD_FRONT,
+	LINKED_LIST_OP_ADD_BACK,
+	LINKED_LIST_OP_FRONT,
+	LINKED_LIST_OP_BACK,
+	LINKED_LIST_OP_REMOVE_FRONT,
+	LINKED_LIST_OP_REMOVE_BACK,
+	LINKED_LIST_OP_ADD_FRONT_N,
+	LINKED_LIST_OP_ADD_BACK_N,
+	LINKED_LIST_OP_REMOVE_FRONT_N,
+	LINKED_LIST_OP_REMOVE_BACK_N,
+	LINKED_LIST_OP_CONCAT,
+	LINKED_LIST_OP_SPLIT_AT,
+	LINKED_LIST_OP_SORT,
+	LINKED_LIST_OP_ADD,
+	LINKED_LIST_OP_CONTAINS,
+	LINKED_LIST_OP_REMOVE,
+	LINKED_LIST_OP_REMOVE_ALL,
+	LINKED_LIST_OP_REMOVE_IF,
+	LINKED_LIST_OP_PRINT,		// linkedListPrint, PrintFile and PrintBuffer
+	LINKED_LIST_OP_SAVE,
+	LINKED_LIST_OP_LOAD,
+	LINKED_LIST_OP_SNAPSHOT,
+	LINKED_LIST_OPS
+};
+
+/* bucket i of a histogram counts samples in [2^i, 2^(i+1)); bucket 0 also counts 0 */
+#define LINKED_LIST_HISTOGRAM_BUCKETS 32
+
+// Counters reported by linkedListStats
+struct LinkedListStats
+{
+	long calls[LINKED_LIST_OPS];
+	long long totalNs[LINKED_LIST_OPS];
+	long latency[LINKED_LIST_OPS][LINKED_LIST_HISTOGRAM_BUCKETS];	// ns per call
+	long scans;					// contains/remove lookups that traversed the list
+	long scannedLinks;			// links compared by those traversals
+	long longestScan;
+	long scanLength[LINKED_LIST_HISTOGRAM_BUCKETS];				// links per traversal
+	int peakSize;				// largest size after any call
+	long bytesAllocated;		// list, slab, index and bloom filter memory requested
+};
+#endif
+
 struct LinkedList;
+struct LinkedListSnapshot;
 
 struct LinkedList* linkedListCreate();
+struct LinkedList* linkedListCreateWithCapacity(int capacity);
+struct LinkedList* linkedListCreateWithFlags(int capacity, int flags);
 void linkedListDestroy(struct LinkedList* list);
 void linkedListPrint(struct LinkedList* list);
 
@@ -29,10 +108,63 @@ TYPE linkedListBack(struct LinkedList* list);
 void linkedListRemoveFront(struct LinkedList* list);
 void linkedListRemoveBack(struct LinkedList* list);
 
+// Allocator interface (linkedList.c only)
+
+struct LinkedList* linkedListCreateWithAllocator(int capacity, int flags, const struct Allocator* allocator);
+
+// Bulk deque interface (linkedList.c only)
+
+void linkedListAddFrontN(struct LinkedList* list, const TYPE* values, int n);
+void linkedListAddBackN(struct LinkedList* list, const TYPE* values, int n);
+int linkedListRemoveFrontN(struct LinkedList* list, TYPE* out, int n);
+int linkedListRemoveBackN(struct LinkedList* list, TYPE* out, int n);
+
+// Splice and sort interface (linkedList.c only)
+// Lists that concat or split share one unlocked pool until all are destroyed
+
+void linkedListConcat(struct LinkedList* dst, struct LinkedList* src);
+struct LinkedList* linkedListSplitAt(struct LinkedList* list, int k);
+void linkedListSort(struct LinkedList* list);
+
 // Bag interface
 
 void linkedListAdd(struct LinkedList* list, TYPE value);
 int linkedListContains(struct LinkedList* list, TYPE value);
 void linkedListRemove(struct LinkedList* list, TYPE value);
 
+// Bulk bag interface (linkedList.c only)
+
+int linkedListRemoveAll(struct LinkedList* bag, TYPE value);
+int linkedListRemoveIf(struct LinkedList* bag, int (*predicate)(TYPE value, void* ctx), void* ctx);
+
+// Buffered print interface (linkedList.c only)
+
+int linkedListPrintFile(struct LinkedList* list, FILE* out);
+size_t linkedListPrintBuffer(struct LinkedList* list, char* buffer, size_t size);
+
+// Lookup statistics (linkedList.c only)
+
+void linkedListBloomStats(struct LinkedList* bag, struct LinkedListBloomStats* stats);
+long linkedListProbeCount(struct LinkedList* bag);
+
+// Snapshot interface (linkedList.c only)
+
+struct LinkedListSnapshot* linkedListSnapshot(struct LinkedList* list);
+int linkedListSnapshotSize(struct LinkedListSnapshot* snapshot);
+void linkedListSnapshotForEach(struct LinkedListSnapshot* snapshot, void (*visit)(TYPE value, void* ctx), void* ctx);
+void linkedListSnapshotRelease(struct LinkedListSnapshot* snapshot);
+
+#ifdef LINKED_LIST_STATS
+// Instrumentation interface (linkedList.c built with -DLINKED_LIST_STATS only)
+
+void linkedListStats(struct LinkedList* list, struct LinkedListStats* stats);
+void linkedListStatsDump(struct LinkedList* list, FILE* out);
+void linkedListStatsDestroyed(struct LinkedListStats* stats);
+#endif
+
+// Binary image interface (linkedList.c only)
+
+int linkedListSave(struct LinkedList* list, const char* path);
+struct LinkedList* linkedListLoad(const char* path);
+
 #endif
\ No newline at end of file
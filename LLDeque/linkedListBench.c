@@ -0,0 +1,549 @@
+/***********************************************************
+* Filename: linkedListBench.c
+*
+* Overview:
+*   Micro-benchmarks for the linked list deque/bag. Each
+*	benchmark is selected by name on the command line; with
+*	no arguments every benchmark is run.
+*		- scaling: pushes and pops 10^3 .. 10^7 values at
+*		  each end of the deque and reports ns/op, which
+*		  should stay flat as the deque grows
+*		- churn: a random mix of the six deque operations on a
+*		  deque holding about 10^2 .. 10^6 values, in ns/op
+*		- memory: heap bytes per value held by the deque
+*		- scan: values per second visited by linkedListContains
+*		  when the value is absent (a full traversal)
+*		- print: time to print 10^6 values to /dev/null with
+*		  linkedListPrint vs linkedListPrintFile (linkedList.c)
+*		- sort: linkedListSort vs copying out, qsort and rebuilding
+*		  at 10^6 and 10^7 values (linkedList.c)
+*		- zipf: average probe length of Zipf-distributed
+*		  linkedListContains lookups with the static order,
+*		  move-to-front and transpose (linkedList.c)
+*		- snapshot: cost of linkedListSnapshot vs copying the
+*		  values out, and writer queue ns/op with and without
+*		  a live snapshot (linkedList.c)
+*		- traverse: ns and dTLB load misses per link of a full
+*		  linkedListContains scan and of linkedListPrintFile over
+*		  4 * 10^6 sorted (so scattered) links, in slabs from
+*		  malloc, an arena and a huge-page arena (linkedList.c);
+*		  the misses are read with perf_event_open and shown as
+*		  n/a where perf events are unavailable (perfCounter.h)
+*	Benchmarks of the linkedList.h deque/bag interface build
+*	against every implementation; use 'make benchall' to get one
+*	binary per implementation. Benchmarks of functions only
+*	linkedList.c provides are built when BENCH_EXTENSIONS is
+*	defined.
+*
+* Usage:
+*	1) make -f makefileLLDequeBag bench
+*	2) ./bench [scaling|churn|memory|scan|print|sort|zipf|snapshot|traverse]
+************************************************************/
+#define _POSIX_C_SOURCE 199309L
+#define _DEFAULT_SOURCE		// mmap huge page flags (allocator.h), syscall (perfCounter.h)
+#include "linkedList.h"
+#include "../perfCounter.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+/**
+	Returns a monotonic timestamp in nanoseconds.
+ */
+static double nowNs()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+/**
+	Pushes n values and pops them again at the front, the back and
+	(as a queue) back-to-front, printing the average ns per operation.
+ */
+static void benchScaling()
+{
+	printf("%-10s %14s %14s %14s\n", "n", "front ns/op", "back ns/op", "queue ns/op");
+	for (long n = 1000; n <= 10000000; n *= 10)
+	{
+		struct LinkedList* list = linkedListCreate();
+		double start, front, back, queue;
+
+		start = nowNs();
+		for (long i = 0; i < n; i++)
+			linkedListAddFront(list, (TYPE)i);
+		for (long i = 0; i < n; i++)
+			linkedListRemoveFront(list);
+		front = (nowNs() - start) / (2.0 * n);
+
+		start = nowNs();
+		for (long i = 0; i < n; i++)
+			linkedListAddBack(list, (TYPE)i);
+		for (long i = 0; i < n; i++)
+			linkedListRemoveBack(list);
+		back = (nowNs() - start) / (2.0 * n);
+
+		start = nowNs();
+		for (long i = 0; i < n; i++)
+			linkedListAddBack(list, (TYPE)i);
+		for (long i = 0; i < n; i++)
+			linkedListRemoveFront(list);
+		queue = (nowNs() - start) / (2.0 * n);
+
+		printf("%-10ld %14.1f %14.1f %14.1f\n", n, front, back, queue);
+		linkedListDestroy(list);
+	}
+}
+
+/**
+	Runs 10^7 deque operations, each an add, a peek-and-remove at a
+	random end, on a deque kept near n values, and prints ns/op. The
+	operation sequence is the same for every implementation.
+ */
+static void benchChurn()
+{
+	const long ops = 10000000;
+
+	printf("%-10s %14s\n", "n", "ns/op");
+	for (long n = 100; n <= 1000000; n *= 100)
+	{
+		struct LinkedList* list = linkedListCreate();
+		for (long i = 0; i < n; i++)
+			linkedListAddBack(list, (TYPE)i);
+
+		unsigned int x = 2463534242u;
+		long size = n;
+		long long sum = 0;
+		double start = nowNs();
+		for (long i = 0; i < ops; i++)
+		{
+			x ^= x << 13;
+			x ^= x >> 17;
+			x ^= x << 5;
+
+			/* add or remove with equal odds, pulled back toward n */
+			int add = (size < n / 2) || (size < 2 * n && (x & 4));
+			if (add)
+			{
+				if (x & 1)
+					linkedListAddFront(list, (TYPE)i);
+				else
+					linkedListAddBack(list, (TYPE)i);
+				size++;
+			}
+			else if (x & 1)
+			{
+				sum += linkedListFront(list);
+				linkedListRemoveFront(list);
+				size--;
+			}
+			else
+			{
+				sum += linkedListBack(list);
+				linkedListRemoveBack(list);
+				size--;
+			}
+		}
+		double elapsed = nowNs() - start;
+
+		printf("%-10ld %14.1f\n", n, elapsed / ops);
+		if (sum == 42)
+			printf("\n");	// keeps sum live
+		linkedListDestroy(list);
+	}
+}
+
+/**
+	Returns the number of heap bytes currently in use, including large
+	blocks the C library maps separately, or -1 if it cannot report it.
+ */
+static long heapInUse()
+{
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+	struct mallinfo2 info = mallinfo2();
+	return (long)(info.uordblks + info.hblkhd);
+#else
+	return -1;
+#endif
+}
+
+/**
+	Fills a deque from the back and reports how many heap bytes it
+	holds per value (list header and sentinels included).
+ */
+static void benchMemory()
+{
+	printf("%-10s %14s\n", "n", "bytes/value");
+	for (long n = 1000; n <= 1000000; n *= 10)
+	{
+		long before = heapInUse();
+		struct LinkedList* list = linkedListCreate();
+		for (long i = 0; i < n; i++)
+			linkedListAddBack(list, (TYPE)i);
+		long after = heapInUse();
+
+		if (before < 0 || after < 0)
+			printf("%-10ld %14s\n", n, "n/a");
+		else
+			printf("%-10ld %14.2f\n", n, (double)(after - before) / n);
+		linkedListDestroy(list);
+	}
+}
+
+/**
+	Searches a deque of n values for a value it does not hold, so each
+	search visits every value, and reports values visited per second.
+ */
+static void benchScan()
+{
+	printf("%-10s %14s\n", "n", "Mvalues/s");
+	for (long n = 1000; n <= 1000000; n *= 10)
+	{
+		struct LinkedList* list = linkedListCreate();
+		for (long i = 0; i < n; i++)
+			linkedListAddBack(list, (TYPE)i);
+
+		long reps = 100000000 / n;
+		int found = 0;
+		double start = nowNs();
+		for (long r = 0; r < reps; r++)
+			found += linkedListContains(list, (TYPE)-1);
+		double elapsed = nowNs() - start;
+
+		if (found)
+			printf("unexpected match\n");
+		printf("%-10ld %14.1f\n", n, (double)n * reps / elapsed * 1e3);
+		linkedListDestroy(list);
+	}
+}
+
+#ifdef BENCH_EXTENSIONS
+/**
+	Prints a deque of 10^6 values to /dev/null through stdout with
+	linkedListPrint and through a FILE with linkedListPrintFile.
+ */
+static void benchPrint()
+{
+	long n = 1000000;
+	struct LinkedList* list = linkedListCreate();
+	for (long i = 0; i < n; i++)
+		linkedListAddBack(list, (TYPE)(i * 7919));
+
+	FILE* devNull = fopen("/dev/null", "w");
+
+	/* point stdout at /dev/null while linkedListPrint runs */
+	fflush(stdout);
+	int savedStdout = dup(STDOUT_FILENO);
+	dup2(fileno(devNull), STDOUT_FILENO);
+
+	double start = nowNs();
+	linkedListPrint(list);
+	fflush(stdout);
+	double printfNs = nowNs() - start;
+
+	dup2(savedStdout, STDOUT_FILENO);
+	close(savedStdout);
+
+	start = nowNs();
+	linkedListPrintFile(list, devNull);
+	fflush(devNull);
+	double bufferedNs = nowNs() - start;
+
+	printf("%-22s %10s\n", "print 10^6 values", "ns/value");
+	printf("%-22s %10.1f\n", "linkedListPrint", printfNs / n);
+	printf("%-22s %10.1f\n", "linkedListPrintFile", bufferedNs / n);
+
+	fclose(devNull);
+	linkedListDestroy(list);
+}
+
+static int compareValues(const void* a, const void* b)
+{
+	TYPE x = *(const TYPE*)a;
+	TYPE y = *(const TYPE*)b;
+	return LT(x, y) ? -1 : (LT(y, x) ? 1 : 0);
+}
+
+/**
+	Fills a deque with n pseudo-random values, xorshift seeded so both
+	sort paths see the same input.
+ */
+static struct LinkedList* randomList(long n)
+{
+	struct LinkedList* list = linkedListCreateWithCapacity((int)n);
+	unsigned int x = 2463534242u;
+	for (long i = 0; i < n; i++)
+	{
+		x ^= x << 13;
+		x ^= x >> 17;
+		x ^= x << 5;
+		linkedListAddBack(list, (TYPE)(x % 1000000000u));
+	}
+	return list;
+}
+
+/**
+	Sorts n random values with linkedListSort, and by copying them out
+	of the deque, calling qsort and adding them back in bulk.
+ */
+static void benchSort()
+{
+	printf("%-10s %14s %14s\n", "n", "sort ms", "qsort copy ms");
+	for (long n = 1000000; n <= 10000000; n *= 10)
+	{
+		struct LinkedList* list = randomList(n);
+		double start = nowNs();
+		linkedListSort(list);
+		double sortMs = (nowNs() - start) / 1e6;
+		linkedListDestroy(list);
+
+		list = randomList(n);
+		TYPE* values = malloc((size_t)n * sizeof(TYPE));
+		start = nowNs();
+		linkedListRemoveFrontN(list, values, (int)n);
+		qsort(values, (size_t)n, sizeof(TYPE), compareValues);
+		linkedListAddBackN(list, values, (int)n);
+		double qsortMs = (nowNs() - start) / 1e6;
+		free(values);
+		linkedListDestroy(list);
+
+		printf("%-10ld %14.1f %14.1f\n", n, sortMs, qsortMs);
+	}
+}
+
+/**
+	Looks up values drawn from a Zipf distribution (exponent 1) over
+	10^4 distinct values, added in shuffled order, and reports the
+	average number of links each lookup visits and its ns/lookup
+	with the static order, move-to-front and transpose.
+ */
+static void benchZipf()
+{
+	const int n = 10000;
+	const long lookups = 2000000;
+	const int modes[] = { 0, LINKED_LIST_MOVE_TO_FRONT, LINKED_LIST_TRANSPOSE };
+	const char* names[] = { "static", "move-to-front", "transpose" };
+
+	/* cumulative Zipf weights, rank r has weight 1/r */
+	double* cdf = malloc((size_t)n * sizeof(double));
+	double total = 0;
+	for (int r = 0; r < n; r++)
+	{
+		total += 1.0 / (r + 1);
+		cdf[r] = total;
+	}
+
+	/* value of rank r is order[r]; the list holds them shuffled */
+	TYPE* order = malloc((size_t)n * sizeof(TYPE));
+	unsigned int x = 2463534242u;
+	for (int i = 0; i < n; i++)
+		order[i] = (TYPE)i;
+	for (int i = n - 1; i > 0; i--)
+	{
+		x ^= x << 13;
+		x ^= x >> 17;
+		x ^= x << 5;
+		int j = (int)(x % (unsigned int)(i + 1));
+		TYPE t = order[i];
+		order[i] = order[j];
+		order[j] = t;
+	}
+
+	/* draw the lookups once so every mode sees the same sequence */
+	TYPE* keys = malloc((size_t)lookups * sizeof(TYPE));
+	for (long k = 0; k < lookups; k++)
+	{
+		x ^= x << 13;
+		x ^= x >> 17;
+		x ^= x << 5;
+		double u = (double)x / 4294967296.0 * total;
+		int lo = 0, hi = n - 1;
+		while (lo < hi)
+		{
+			int mid = (lo + hi) / 2;
+			if (cdf[mid] < u)
+				lo = mid + 1;
+			else
+				hi = mid;
+		}
+		keys[k] = order[lo];
+	}
+
+	printf("%-16s %14s %14s\n", "mode", "probes/lookup", "ns/lookup");
+	for (int m = 0; m < 3; m++)
+	{
+		struct LinkedList* bag = linkedListCreateWithFlags(n, modes[m]);
+		for (int i = 0; i < n; i++)
+			linkedListAddBack(bag, (TYPE)i);
+
+		int found = 0;
+		double start = nowNs();
+		for (long k = 0; k < lookups; k++)
+			found += linkedListContains(bag, keys[k]);
+		double elapsed = nowNs() - start;
+
+		if (found != lookups)
+			printf("unexpected miss\n");
+		printf("%-16s %14.1f %14.1f\n", names[m],
+			(double)linkedListProbeCount(bag) / lookups, elapsed / lookups);
+		linkedListDestroy(bag);
+	}
+
+	free(keys);
+	free(order);
+	free(cdf);
+}
+
+static void copyValue(TYPE value, void* ctx)
+{
+	TYPE** out = ctx;
+	*(*out)++ = value;
+}
+
+/**
+	For deques of 10^4 and 10^6 values, times taking (and releasing)
+	a snapshot against copying every value out, then the writer's
+	ns per AddBack + RemoveFront pair with no snapshot and while a
+	snapshot taken before the run is live.
+ */
+static void benchSnapshot()
+{
+	printf("%-10s %14s %14s %14s %14s\n", "n", "snapshot ns", "copy ns", "queue ns/op", "shared ns/op");
+	for (long n = 10000; n <= 1000000; n *= 100)
+	{
+		struct LinkedList* list = linkedListCreate();
+		for (long i = 0; i < n; i++)
+			linkedListAddBack(list, (TYPE)i);
+
+		double start = nowNs();
+		struct LinkedListSnapshot* snapshot = linkedListSnapshot(list);
+		double snapshotNs = nowNs() - start;
+
+		TYPE* values = malloc((size_t)n * sizeof(TYPE));
+		TYPE* out = values;
+		start = nowNs();
+		linkedListSnapshotForEach(snapshot, copyValue, &out);
+		double copyNs = nowNs() - start;
+		free(values);
+		linkedListSnapshotRelease(snapshot);
+
+		/* first pass runs with no snapshot, second with one live throughout */
+		double opNs[2];
+		for (int shared = 0; shared < 2; shared++)
+		{
+			snapshot = shared ? linkedListSnapshot(list) : 0;
+			start = nowNs();
+			for (long i = 0; i < n; i++)
+			{
+				linkedListAddBack(list, (TYPE)i);
+				linkedListRemoveFront(list);
+			}
+			opNs[shared] = (nowNs() - start) / (2.0 * n);
+			if (snapshot != 0)
+				linkedListSnapshotRelease(snapshot);
+		}
+
+		printf("%-10ld %14.0f %14.0f %14.1f %14.1f\n", n, snapshotNs, copyNs, opNs[0], opNs[1]);
+		linkedListDestroy(list);
+	}
+}
+
+/**
+	Traverses 4 * 10^6 links, sorted so that list order jumps all over
+	memory, with a full linkedListContains scan and with
+	linkedListPrintFile, for links from malloc, an arena and a
+	huge-page arena, reporting ns and dTLB load misses per link. No
+	capacity hint is given, so the list grows its slabs as it would
+	in use; circularListBench's traverse has the one-malloc-per-link
+	baseline.
+ */
+static void benchTraverse()
+{
+	static const char* const pageKinds[] = { "normal", "transparent", "hugetlb" };
+	long n = 4000000;
+	int fd = dtlbCounterOpen();
+	FILE* devNull = fopen("/dev/null", "w");
+
+	printf("%-8s %-12s %12s %12s %12s %12s\n", "links", "pages", "scan ns", "scan dTLB", "print ns", "print dTLB");
+	for (int mode = 0; mode < 3; mode++)
+	{
+		struct Arena* arena = (mode == 0) ? 0 : (mode == 1) ? arenaCreate(0) : arenaCreateHuge(0);
+		struct Allocator allocator = (arena != 0) ? arenaAllocator(arena) : allocatorMalloc();
+		struct LinkedList* list = linkedListCreateWithAllocator(0, 0, &allocator);
+
+		unsigned int x = 2463534242u;
+		for (long i = 0; i < n; i++)
+		{
+			x ^= x << 13;
+			x ^= x >> 17;
+			x ^= x << 5;
+			linkedListAddBack(list, (TYPE)(x % 1000000000u));
+		}
+		linkedListSort(list);
+
+		counterStart(fd);
+		double start = nowNs();
+		int found = linkedListContains(list, (TYPE)-1);
+		double scanNs = nowNs() - start;
+		long long scanMisses = counterStop(fd);
+
+		counterStart(fd);
+		start = nowNs();
+		linkedListPrintFile(list, devNull);
+		fflush(devNull);
+		double printNs = nowNs() - start;
+		long long printMisses = counterStop(fd);
+
+		if (found)
+			printf("unexpected match\n");
+		char scanText[32], printText[32];
+		printf("%-8s %-12s %12.1f %12s %12.1f %12s\n",
+			(mode == 0) ? "malloc" : (mode == 1) ? "arena" : "huge",
+			pageKinds[(arena != 0) ? arenaPageKind(arena) : 0],
+			scanNs / n, perValue(scanText, sizeof(scanText), scanMisses, n),
+			printNs / n, perValue(printText, sizeof(printText), printMisses, n));
+
+		linkedListDestroy(list);
+		if (arena != 0)
+			arenaDestroy(arena);
+	}
+
+	fclose(devNull);
+	if (fd >= 0)
+		close(fd);
+}
+#endif
+
+int main(int argc, char** argv)
+{
+	int all = (argc < 2);
+
+	if (all || strcmp(argv[1], "scaling") == 0)
+		benchScaling();
+	if (all || strcmp(argv[1], "churn") == 0)
+		benchChurn();
+	if (all || strcmp(argv[1], "memory") == 0)
+		benchMemory();
+	if (all || strcmp(argv[1], "scan") == 0)
+		benchScan();
+#ifdef BENCH_EXTENSIONS
+	if (all || strcmp(argv[1], "print") == 0)
+		benchPrint();
+	if (all || strcmp(argv[1], "sort") == 0)
+		benchSort();
+	if (all || strcmp(argv[1], "zipf") == 0)
+		benchZipf();
+	if (all || strcmp(argv[1], "snapshot") == 0)
+		benchSnapshot();
+	if (all || strcmp(argv[1], "traverse") == 0)
+		benchTraverse();
+#endif
+
+	return 0;
+}
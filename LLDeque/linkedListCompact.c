@@ -0,0 +1,1119 @@
+/***********************************************************
+* Filename: linkedListCompact.c
+*
+* Overview:
+*   This program is a compact implementation of the deque and
+*	bag ADTs declared in linkedList.h, including the functions
+*	marked "linkedList.c only". It is a drop-in replacement for
+*	linkedList.c, selected at build time with:
+*		make -f makefileLLDequeBag LIST_IMPL=linkedListCompact
+*
+*	Like linkedList.c it is a doubly linked list with a front
+*	and a back sentinel, but every node lives in one growable
+*	array and nodes are linked by 32-bit array indices instead
+*	of pointers. Nodes 0 and 1 are the front and back sentinels.
+*	Removed nodes are recycled through a free list threaded
+*	through their next indices (0 ends it, since the front
+*	sentinel is never free). Growth doubles the array with a
+*	single realloc, so for an int TYPE each node takes 12 bytes
+*	instead of the 24 of a pointer-linked struct Link.
+*
+*	Because nodes are addressed by index, lists cannot share
+*	nodes: concat and split copy the moved values, which is
+*	O(moved values) rather than O(1). Sort copies the values
+*	out, merge sorts them and lays the nodes out again in
+*	order, which also packs the array. Growth may move every
+*	node, so snapshots cannot share nodes either: they copy the
+*	values, which is O(size) rather than O(1).
+*
+*	linkedListCreateWithAllocator takes the header and node
+*	array from the caller's allocator (see allocator.h); since
+*	an allocator has no realloc, the array grows by allocating,
+*	copying and freeing unless the allocator is malloc's.
+*
+*	Note that LINKED_LIST_HASHED and LINKED_LIST_BLOOM are
+*	accepted for API compatibility but have no effect; bag
+*	lookups are always a front-to-back scan.
+************************************************************/
+#define _POSIX_C_SOURCE 200809L
+#include "linkedList.h"
+#include <assert.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#ifndef FORMAT_SPECIFIER
+#define FORMAT_SPECIFIER "%d"
+#endif
+
+/* number of nodes (sentinels included) allocated when no capacity hint is given */
+#ifndef NODES_DEFAULT_CAPACITY
+#define NODES_DEFAULT_CAPACITY 64
+#endif
+
+/* node indices of the sentinels; FRONT also ends the free list */
+#define FRONT 0u
+#define BACK 1u
+
+/* identifies a saved list image; must match linkedList.c */
+#define IMAGE_MAGIC 0x4C4C5354u		// "LLST"
+#define IMAGE_VERSION 1u
+
+/* values buffered per read or write of an image */
+#define IMAGE_IO_VALUES 4096
+
+// Double link by index into the list's node array
+struct Node
+{
+	TYPE value;
+	uint32_t next;
+	uint32_t prev;
+};
+
+// Header of a saved list image, followed by count TYPE values
+struct ListImage
+{
+	uint32_t magic;
+	uint32_t version;
+	uint32_t valueSize;		// sizeof(TYPE) of the saving build
+	uint32_t reserved;
+	uint64_t count;
+};
+
+// Read-only copy of a list's values
+struct LinkedListSnapshot
+{
+	int size;
+	TYPE values[];
+};
+
+// Double linked list of nodes in one array
+struct LinkedList
+{
+	struct Node* nodes;
+	uint32_t capacity;		// nodes allocated
+	uint32_t used;			// nodes ever handed out; [used, capacity) are untouched
+	uint32_t freeNodes;		// first recycled node, or FRONT if none
+	int size;
+	int flags;				// LINKED_LIST_* creation flags
+	long probes;			// nodes visited by bag lookup scans
+	struct Allocator allocator;	// source of the header and node array
+};
+
+/**
+	Grows the node array, by doubling, until it holds at least n nodes.
+	param: 	list 	struct LinkedList ptr
+	param:	n		number of nodes needed
+	post:	list->capacity >= n
+ */
+static void reserveNodes(struct LinkedList* list, uint64_t n)
+{
+	if (n <= list->capacity)
+	{
+		return;
+	}
+	assert(n <= UINT32_MAX);
+
+	uint64_t capacity = list->capacity;
+	while (capacity < n)
+	{
+		capacity *= 2;
+	}
+	if (capacity > UINT32_MAX)
+	{
+		capacity = UINT32_MAX;
+	}
+
+	struct Node* nodes;
+	if (list->allocator.isMalloc)
+	{
+		nodes = realloc(list->nodes, (size_t)capacity * sizeof(struct Node));
+		assert(nodes != 0);
+	}
+	else
+	{
+		nodes = list->allocator.alloc(list->allocator.context, (size_t)capacity * sizeof(struct Node));
+		assert(nodes != 0);
+		memcpy(nodes, list->nodes, (size_t)list->used * sizeof(struct Node));
+		list->allocator.free(list->allocator.context, list->nodes, (size_t)list->capacity * sizeof(struct Node));
+	}
+	list->nodes = nodes;
+	list->capacity = (uint32_t)capacity;
+}
+
+/**
+	Returns the index of an unused node, recycling a freed one first.
+	param: 	list 	struct LinkedList ptr
+	ret:	node index; the node's fields are unset
+ */
+static uint32_t allocNode(struct LinkedList* list)
+{
+	if (list->freeNodes != FRONT)
+	{
+		uint32_t i = list->freeNodes;
+		list->freeNodes = list->nodes[i].next;
+		return i;
+	}
+
+	reserveNodes(list, (uint64_t)list->used + 1);
+	return list->used++;
+}
+
+/**
+	Initializes a list whose array holds capacity values.
+	param: 	list 	struct LinkedList ptr
+	param:	capacity	expected number of values
+	param:	flags	bitwise or of LINKED_LIST_* flags
+	post:	list is empty, with its sentinels at nodes 0 and 1
+ */
+static void init(struct LinkedList* list, int capacity, int flags)
+{
+	uint64_t nodes = (capacity > 0) ? (uint64_t)capacity + 2 : NODES_DEFAULT_CAPACITY;
+	assert(nodes <= UINT32_MAX);
+
+	list->nodes = list->allocator.alloc(list->allocator.context, (size_t)nodes * sizeof(struct Node));
+	assert(list->nodes != 0);
+	list->capacity = (uint32_t)nodes;
+	list->used = 2;
+	list->freeNodes = FRONT;
+
+	list->nodes[FRONT].next = BACK;
+	list->nodes[FRONT].prev = FRONT;
+	list->nodes[BACK].next = BACK;
+	list->nodes[BACK].prev = FRONT;
+
+	list->size = 0;
+	list->flags = flags;
+	list->probes = 0;
+}
+
+/**
+	Links a new node with the given value in before the node at.
+	param: 	list 	struct LinkedList ptr
+	param:	at		node index in list (not the front sentinel)
+	param: 	value 	TYPE
+	post:	size is increased by 1
+ */
+static void addNodeBefore(struct LinkedList* list, uint32_t at, TYPE value)
+{
+	/* allocate first: growing the array moves every node */
+	uint32_t i = allocNode(list);
+	struct Node* nodes = list->nodes;
+
+	nodes[i].value = value;
+	nodes[i].next = at;
+	nodes[i].prev = nodes[at].prev;
+	nodes[nodes[at].prev].next = i;
+	nodes[at].prev = i;
+	list->size += 1;
+}
+
+/**
+	Unlinks a node and puts it on the free list.
+	param: 	list 	struct LinkedList ptr
+	param:	i		node index in list (not a sentinel)
+	post:	size is decreased by 1
+ */
+static void removeNode(struct LinkedList* list, uint32_t i)
+{
+	struct Node* nodes = list->nodes;
+	assert(i != FRONT && i != BACK);
+
+	nodes[nodes[i].prev].next = nodes[i].next;
+	nodes[nodes[i].next].prev = nodes[i].prev;
+	nodes[i].next = list->freeNodes;
+	list->freeNodes = i;
+	list->size -= 1;
+}
+
+/**
+	Links n new nodes holding values[0..n-1], in order, before the
+	node at, growing the array at most once.
+	param: 	list 	struct LinkedList ptr
+	param:	at		node index in list (not the front sentinel)
+	param: 	values 	array of n TYPE values
+	param:	n		number of values, > 0
+ */
+static void addNodesBefore(struct LinkedList* list, uint32_t at, const TYPE* values, int n)
+{
+	reserveNodes(list, (uint64_t)list->used + (uint64_t)n);
+	for (int i = 0; i < n; i++)
+	{
+		addNodeBefore(list, at, values[i]);
+	}
+}
+
+/**
+	Empties the list, keeping its array.
+	param: 	list 	struct LinkedList ptr
+	post:	list is empty and every node but the sentinels is unused
+ */
+static void clear(struct LinkedList* list)
+{
+	list->nodes[FRONT].next = BACK;
+	list->nodes[BACK].prev = FRONT;
+	list->used = 2;
+	list->freeNodes = FRONT;
+	list->size = 0;
+}
+
+/**
+	Copies the list's values, front to back, into out.
+	param: 	list 	struct LinkedList ptr
+	param:	out		buffer for size values
+ */
+static void copyValues(struct LinkedList* list, TYPE* out)
+{
+	int n = 0;
+	for (uint32_t i = list->nodes[FRONT].next; i != BACK; i = list->nodes[i].next)
+	{
+		out[n++] = list->nodes[i].value;
+	}
+}
+
+/**
+	Allocates and initializes a list.
+	pre: 	none
+	post: 	memory allocated for new struct LinkedList ptr
+	return: list
+ */
+struct LinkedList* linkedListCreate()
+{
+	return linkedListCreateWithFlags(0, 0);
+}
+
+/**
+	Allocates and initializes a list whose node array is sized for
+	capacity values, so the first capacity adds do not grow it.
+	param:	capacity	expected number of values
+	return: list
+ */
+struct LinkedList* linkedListCreateWithCapacity(int capacity)
+{
+	return linkedListCreateWithFlags(capacity, 0);
+}
+
+/**
+	Allocates and initializes a list sized for capacity values. Of
+	the LINKED_LIST_* flags only LINKED_LIST_MOVE_TO_FRONT and
+	LINKED_LIST_TRANSPOSE have an effect.
+	param:	capacity	expected number of values
+	param:	flags		bitwise or of LINKED_LIST_* flags
+	return: list
+ */
+struct LinkedList* linkedListCreateWithFlags(int capacity, int flags)
+{
+	return linkedListCreateWithAllocator(capacity, flags, 0);
+}
+
+/**
+	Allocates and initializes a list whose header and node array come
+	from the given allocator.
+	param:	capacity	expected number of values
+	param:	flags		bitwise or of LINKED_LIST_* flags
+	param:	allocator	struct Allocator ptr, copied; NULL for malloc
+	return: list
+ */
+struct LinkedList* linkedListCreateWithAllocator(int capacity, int flags, const struct Allocator* allocator)
+{
+	struct Allocator source = allocator != 0 ? *allocator : allocatorMalloc();
+	assert(source.alloc != 0 && source.free != 0);
+
+	struct LinkedList* list = source.alloc(source.context, sizeof(struct LinkedList));
+	assert(list != 0);
+	list->allocator = source;
+	init(list, capacity, flags);
+	return list;
+}
+
+/**
+	Frees the list's node array and the list itself.
+	param:	list 	struct LinkedList ptr
+	pre: 	list is not null
+ */
+void linkedListDestroy(struct LinkedList* list)
+{
+	assert(list != NULL);
+	struct Allocator allocator = list->allocator;
+	allocator.free(allocator.context, list->nodes, (size_t)list->capacity * sizeof(struct Node));
+	allocator.free(allocator.context, list, sizeof(struct LinkedList));
+}
+
+/**
+	Adds a new value to the front of the deque.
+	param: 	deque 	struct LinkedList ptr
+	param: 	value 	TYPE
+	pre: 	deque is not null
+	post: 	value is the deque's front
+ */
+void linkedListAddFront(struct LinkedList* deque, TYPE value)
+{
+	assert(deque != 0);
+	addNodeBefore(deque, deque->nodes[FRONT].next, value);
+}
+
+/**
+	Adds a new value to the back of the deque.
+	param: 	deque 	struct LinkedList ptr
+	param: 	value 	TYPE
+	pre: 	deque is not null
+	post: 	value is the deque's back
+ */
+void linkedListAddBack(struct LinkedList* deque, TYPE value)
+{
+	assert(deque != 0);
+	addNodeBefore(deque, BACK, value);
+}
+
+/**
+	Returns the value at the front of the deque.
+	param: 	deque 	struct LinkedList ptr
+	pre: 	deque is not null and not empty
+	ret: 	the front value
+ */
+TYPE linkedListFront(struct LinkedList* deque)
+{
+	assert(deque != 0);
+	assert(!linkedListIsEmpty(deque));
+	return deque->nodes[deque->nodes[FRONT].next].value;
+}
+
+/**
+	Returns the value at the back of the deque.
+	param: 	deque 	struct LinkedList ptr
+	pre: 	deque is not null and not empty
+	ret: 	the back value
+ */
+TYPE linkedListBack(struct LinkedList* deque)
+{
+	assert(deque != 0);
+	assert(!linkedListIsEmpty(deque));
+	return deque->nodes[deque->nodes[BACK].prev].value;
+}
+
+/**
+	Removes the value at the front of the deque.
+	param: 	deque 	struct LinkedList ptr
+	pre: 	deque is not null and not empty
+	post: 	the front node is on the free list
+ */
+void linkedListRemoveFront(struct LinkedList* deque)
+{
+	assert(deque != 0);
+	assert(!linkedListIsEmpty(deque));
+	removeNode(deque, deque->nodes[FRONT].next);
+}
+
+/**
+	Removes the value at the back of the deque.
+	param: 	deque 	struct LinkedList ptr
+	pre: 	deque is not null and not empty
+	post: 	the back node is on the free list
+ */
+void linkedListRemoveBack(struct LinkedList* deque)
+{
+	assert(deque != 0);
+	assert(!linkedListIsEmpty(deque));
+	removeNode(deque, deque->nodes[BACK].prev);
+}
+
+/**
+	Adds n values to the front of the deque in array order, so that
+	values[0] becomes the front. The array grows at most once.
+	param: 	deque 	struct LinkedList ptr
+	param: 	values 	array of n TYPE values
+	param:	n		number of values
+	pre: 	deque is not null
+	pre:	values is not null if n > 0
+	post: 	values are the first n values of the deque
+ */
+void linkedListAddFrontN(struct LinkedList* deque, const TYPE* values, int n)
+{
+	assert(deque != 0);
+	assert(n >= 0);
+
+	if (n > 0)
+	{
+		addNodesBefore(deque, deque->nodes[FRONT].next, values, n);
+	}
+}
+
+/**
+	Adds n values to the back of the deque in array order, as if by
+	n calls to linkedListAddBack. The array grows at most once.
+	param: 	deque 	struct LinkedList ptr
+	param: 	values 	array of n TYPE values
+	param:	n		number of values
+	pre: 	deque is not null
+	pre:	values is not null if n > 0
+	post: 	values are the last n values of the deque
+ */
+void linkedListAddBackN(struct LinkedList* deque, const TYPE* values, int n)
+{
+	assert(deque != 0);
+	assert(n >= 0);
+
+	if (n > 0)
+	{
+		addNodesBefore(deque, BACK, values, n);
+	}
+}
+
+/**
+	Removes up to n values from the front of the deque, copying them
+	front to back into out.
+	param: 	deque 	struct LinkedList ptr
+	param: 	out 	buffer for n values, or NULL to discard them
+	param:	n		maximum number of values to remove
+	pre: 	deque is not null
+	ret:	number of values removed, min(n, size)
+ */
+int linkedListRemoveFrontN(struct LinkedList* deque, TYPE* out, int n)
+{
+	assert(deque != 0);
+	assert(n >= 0);
+
+	if (n > deque->size)
+	{
+		n = deque->size;
+	}
+	for (int i = 0; i < n; i++)
+	{
+		uint32_t front = deque->nodes[FRONT].next;
+		if (out != 0)
+		{
+			out[i] = deque->nodes[front].value;
+		}
+		removeNode(deque, front);
+	}
+	return n;
+}
+
+/**
+	Removes up to n values from the back of the deque, copying them
+	back to front into out.
+	param: 	deque 	struct LinkedList ptr
+	param: 	out 	buffer for n values, or NULL to discard them
+	param:	n		maximum number of values to remove
+	pre: 	deque is not null
+	ret:	number of values removed, min(n, size)
+ */
+int linkedListRemoveBackN(struct LinkedList* deque, TYPE* out, int n)
+{
+	assert(deque != 0);
+	assert(n >= 0);
+
+	if (n > deque->size)
+	{
+		n = deque->size;
+	}
+	for (int i = 0; i < n; i++)
+	{
+		uint32_t back = deque->nodes[BACK].prev;
+		if (out != 0)
+		{
+			out[i] = deque->nodes[back].value;
+		}
+		removeNode(deque, back);
+	}
+	return n;
+}
+
+/**
+	Moves every value of src to the back of dst, leaving src empty.
+	The values are copied into dst's array, so this is O(size of src).
+	param: 	dst 	struct LinkedList ptr
+	param: 	src 	struct LinkedList ptr
+	pre: 	dst and src are not null and are different lists
+	post: 	dst holds its values followed by src's values
+			src is empty
+ */
+void linkedListConcat(struct LinkedList* dst, struct LinkedList* src)
+{
+	assert(dst != 0 && src != 0);
+	assert(dst != src);
+
+	if (linkedListIsEmpty(src))
+	{
+		return;
+	}
+
+	reserveNodes(dst, (uint64_t)dst->used + (uint64_t)src->size);
+	for (uint32_t i = src->nodes[FRONT].next; i != BACK; i = src->nodes[i].next)
+	{
+		addNodeBefore(dst, BACK, src->nodes[i].value);
+	}
+	clear(src);
+}
+
+/**
+	Splits the list after its first k values: the values from position
+	k to the back are copied to a new list with the list's flags and
+	their nodes freed. The split point is found by walking from
+	whichever end is closer, so this is O(min(k, size - k) + size - k).
+	param: 	list 	struct LinkedList ptr
+	param: 	k 		number of values the list keeps
+	pre: 	list is not null
+	pre:	0 <= k <= size
+	post: 	list holds its first k values
+	ret:	new list holding the remaining values, in order
+ */
+struct LinkedList* linkedListSplitAt(struct LinkedList* list, int k)
+{
+	assert(list != 0);
+	assert(k >= 0 && k <= list->size);
+
+	int moved = list->size - k;
+	struct LinkedList* tail = linkedListCreateWithAllocator(moved, list->flags, &list->allocator);
+	if (moved == 0)
+	{
+		return tail;
+	}
+
+	/* find the first node of the tail from the closer end */
+	uint32_t first;
+	if (k <= moved)
+	{
+		first = list->nodes[FRONT].next;
+		for (int i = 0; i < k; i++)
+			first = list->nodes[first].next;
+	}
+	else
+	{
+		first = BACK;
+		for (int i = 0; i < moved; i++)
+			first = list->nodes[first].prev;
+	}
+
+	while (first != BACK)
+	{
+		uint32_t next = list->nodes[first].next;
+		addNodeBefore(tail, BACK, list->nodes[first].value);
+		removeNode(list, first);
+		first = next;
+	}
+	return tail;
+}
+
+/**
+	Merges the sorted runs from[lo, mid) and from[mid, hi) into
+	to[lo, hi), taking from the left run on ties so the merge is stable.
+ */
+static void mergeRuns(const TYPE* from, TYPE* to, int lo, int mid, int hi)
+{
+	int i = lo, j = mid, k = lo;
+	while (i < mid && j < hi)
+	{
+		if (LT(from[j], from[i]))
+			to[k++] = from[j++];
+		else
+			to[k++] = from[i++];
+	}
+	while (i < mid)
+		to[k++] = from[i++];
+	while (j < hi)
+		to[k++] = from[j++];
+}
+
+/**
+	Sorts the list in place into ascending order by LT with a stable,
+	bottom-up merge sort. The values are copied into a buffer and
+	sorted there, then written back to nodes 2 .. size+1 linked in
+	array order, so afterwards a traversal walks the array front to
+	back. O(n log n) time and O(n) extra memory.
+	param: 	list 	struct LinkedList ptr
+	pre: 	list is not null
+	post: 	values are in ascending order; equal values keep their
+			relative order
+ */
+void linkedListSort(struct LinkedList* list)
+{
+	assert(list != 0);
+
+	int n = list->size;
+	if (n < 2)
+	{
+		return;
+	}
+
+	TYPE* a = malloc((size_t)n * 2 * sizeof(TYPE));
+	assert(a != 0);
+	TYPE* b = a + n;
+	copyValues(list, a);
+
+	for (int width = 1; width < n; width *= 2)
+	{
+		for (int lo = 0; lo < n; lo += 2 * width)
+		{
+			int mid = (lo + width < n) ? lo + width : n;
+			int hi = (lo + 2 * width < n) ? lo + 2 * width : n;
+			mergeRuns(a, b, lo, mid, hi);
+		}
+		TYPE* t = a;
+		a = b;
+		b = t;
+	}
+
+	/* lay the nodes out again in sorted order */
+	clear(list);
+	addNodesBefore(list, BACK, a, n);
+	free(a < b ? a : b);
+}
+
+/**
+	Returns 1 if the deque is empty and 0 otherwise.
+	param:	deque	struct LinkedList ptr
+	pre:	deque is not null
+	ret:	1 if its size is 0 (empty), otherwise 0 (not empty)
+ */
+int linkedListIsEmpty(struct LinkedList* deque)
+{
+	assert(deque != 0);
+	return deque->size == 0;
+}
+
+/**
+	Prints the values in the deque from front to back to the given FILE.
+	param:	deque	struct LinkedList ptr
+	param:	out		FILE to write to
+	pre:	deque and out are not null
+	post:	text is written to out
+	ret:	0 on success, -1 if a write to out failed
+ */
+int linkedListPrintFile(struct LinkedList* deque, FILE* out)
+{
+	assert(deque != 0);
+	assert(out != 0);
+
+	if (linkedListIsEmpty(deque))
+	{
+		fprintf(out, "Deque's list is empty...\n");
+		return ferror(out) ? -1 : 0;
+	}
+
+	fprintf(out, "Printing the deque's list of values...\n");
+	for (uint32_t i = deque->nodes[FRONT].next; i != BACK; i = deque->nodes[i].next)
+	{
+		fprintf(out, FORMAT_SPECIFIER " ", deque->nodes[i].value);
+	}
+	fprintf(out, "\n");
+	return ferror(out) ? -1 : 0;
+}
+
+/**
+	Prints the values in the deque from front to back.
+	param:	deque	struct LinkedList ptr
+	pre:	deque is not null
+	ret:	outputs to the console the values from front to back;
+			if empty, prints msg that is empty
+ */
+void linkedListPrint(struct LinkedList* deque)
+{
+	linkedListPrintFile(deque, stdout);
+}
+
+/**
+	Formats the deque as linkedListPrint does into a caller's buffer.
+	Like snprintf, the text is truncated to fit and NUL terminated.
+	param:	deque	struct LinkedList ptr
+	param:	buffer	destination (may be NULL if size is 0)
+	param:	size	size of buffer in chars
+	pre:	deque is not null
+	ret:	length of the full text, excluding the NUL; the text was
+			truncated if this is >= size
+ */
+size_t linkedListPrintBuffer(struct LinkedList* deque, char* buffer, size_t size)
+{
+	assert(deque != 0);
+	assert(buffer != 0 || size == 0);
+
+	size_t total = 0;
+	int len;
+
+	/* each piece is written at the end of what fits so far */
+#define PRINT_PIECE(...) \
+	len = snprintf(total < size ? buffer + total : 0, total < size ? size - total : 0, __VA_ARGS__); \
+	total += (size_t)len
+
+	if (linkedListIsEmpty(deque))
+	{
+		PRINT_PIECE("Deque's list is empty...\n");
+	}
+	else
+	{
+		PRINT_PIECE("Printing the deque's list of values...\n");
+		for (uint32_t i = deque->nodes[FRONT].next; i != BACK; i = deque->nodes[i].next)
+		{
+			PRINT_PIECE(FORMAT_SPECIFIER " ", deque->nodes[i].value);
+		}
+		PRINT_PIECE("\n");
+	}
+#undef PRINT_PIECE
+
+	return total;
+}
+
+/**
+	Adds a value to the bag (at the front).
+	param:	bag		struct LinkedList ptr
+	param: 	value 	TYPE
+	pre: 	bag is not null
+ */
+void linkedListAdd(struct LinkedList* bag, TYPE value)
+{
+	linkedListAddFront(bag, value);
+}
+
+/**
+	Finds the first occurrence of a value in the bag.
+	param:	bag		struct LinkedList ptr
+	param: 	value 	TYPE
+	pre: 	bag is not null
+	ret:	index of the node holding the value, or FRONT if not found
+ */
+static uint32_t findNode(struct LinkedList* bag, TYPE value)
+{
+	const struct Node* nodes = bag->nodes;
+	long probes = 0;
+	uint32_t i;
+
+	for (i = nodes[FRONT].next; i != BACK; i = nodes[i].next)
+	{
+		probes++;
+		if (EQ(nodes[i].value, value))
+		{
+			break;
+		}
+	}
+	bag->probes += probes;
+	return (i == BACK) ? FRONT : i;
+}
+
+/**
+	Moves a found node toward the front of a self-organizing bag:
+	all the way (LINKED_LIST_MOVE_TO_FRONT) or past its predecessor
+	(LINKED_LIST_TRANSPOSE).
+	param:	bag		struct LinkedList ptr
+	param: 	i 		node index in bag
+ */
+static void promoteNode(struct LinkedList* bag, uint32_t i)
+{
+	struct Node* nodes = bag->nodes;
+	uint32_t before;
+	if (bag->flags & LINKED_LIST_MOVE_TO_FRONT)
+	{
+		before = nodes[FRONT].next;
+	}
+	else if (bag->flags & LINKED_LIST_TRANSPOSE)
+	{
+		before = nodes[i].prev;
+	}
+	else
+	{
+		return;
+	}
+
+	if (before == i || before == FRONT)
+	{
+		return;
+	}
+
+	/* unlink, then relink in front of before */
+	nodes[nodes[i].prev].next = nodes[i].next;
+	nodes[nodes[i].next].prev = nodes[i].prev;
+	nodes[i].next = before;
+	nodes[i].prev = nodes[before].prev;
+	nodes[nodes[before].prev].next = i;
+	nodes[before].prev = i;
+}
+
+/**
+	Returns 1 if the value is in the bag and 0 otherwise.
+	param:	bag		struct LinkedList ptr
+	param: 	value 	TYPE
+	pre: 	bag is not null
+	post:	a self-organizing bag has moved the found node toward its front
+	ret:	1 if value found; otherwise, 0
+ */
+int linkedListContains(struct LinkedList* bag, TYPE value)
+{
+	assert(bag != 0);
+
+	uint32_t i = findNode(bag, value);
+	if (i == FRONT)
+	{
+		return 0;
+	}
+	promoteNode(bag, i);
+	return 1;
+}
+
+/**
+	Removes the first occurrence of the value.
+	param:	bag		struct LinkedList ptr
+	param: 	value 	TYPE
+	pre: 	bag is not null
+	post:	if value found, one occurrence is removed
+ */
+void linkedListRemove(struct LinkedList* bag, TYPE value)
+{
+	assert(bag != 0);
+
+	uint32_t i = findNode(bag, value);
+	if (i != FRONT)
+	{
+		removeNode(bag, i);
+	}
+}
+
+/**
+	Removes every node whose value is EQ to the given value, in one
+	front-to-back traversal.
+	param:	bag		struct LinkedList ptr
+	param: 	value 	TYPE
+	pre: 	bag is not null
+	ret:	number of values removed
+ */
+int linkedListRemoveAll(struct LinkedList* bag, TYPE value)
+{
+	assert(bag != 0);
+
+	int removed = 0;
+	uint32_t i = bag->nodes[FRONT].next;
+	while (i != BACK)
+	{
+		uint32_t next = bag->nodes[i].next;
+		if (EQ(bag->nodes[i].value, value))
+		{
+			removeNode(bag, i);
+			removed++;
+		}
+		i = next;
+	}
+	return removed;
+}
+
+/**
+	Removes every node whose value satisfies the predicate, in one
+	front-to-back traversal.
+	param:	bag			struct LinkedList ptr
+	param: 	predicate 	returns nonzero for values to remove
+	param:	ctx			passed through to predicate
+	pre: 	bag and predicate are not null
+	pre:	predicate does not modify the bag
+	ret:	number of values removed
+ */
+int linkedListRemoveIf(struct LinkedList* bag, int (*predicate)(TYPE value, void* ctx), void* ctx)
+{
+	assert(bag != 0);
+	assert(predicate != 0);
+
+	int removed = 0;
+	uint32_t i = bag->nodes[FRONT].next;
+	while (i != BACK)
+	{
+		uint32_t next = bag->nodes[i].next;
+		if (predicate(bag->nodes[i].value, ctx))
+		{
+			removeNode(bag, i);
+			removed++;
+		}
+		i = next;
+	}
+	return removed;
+}
+
+/**
+	Returns a read-only copy of the list's current values. Unlike
+	linkedList.c this is O(size), since nodes move when the array grows.
+	param:	list	struct LinkedList ptr
+	pre: 	list is not null
+	ret:	snapshot; release it with linkedListSnapshotRelease
+ */
+struct LinkedListSnapshot* linkedListSnapshot(struct LinkedList* list)
+{
+	assert(list != 0);
+
+	struct LinkedListSnapshot* snapshot = malloc(sizeof(struct LinkedListSnapshot) + (size_t)list->size * sizeof(TYPE));
+	assert(snapshot != 0);
+	snapshot->size = list->size;
+	copyValues(list, snapshot->values);
+	return snapshot;
+}
+
+/**
+	Returns the number of values in the snapshot.
+	param:	snapshot	struct LinkedListSnapshot ptr
+	pre: 	snapshot is not null
+ */
+int linkedListSnapshotSize(struct LinkedListSnapshot* snapshot)
+{
+	assert(snapshot != 0);
+	return snapshot->size;
+}
+
+/**
+	Calls visit on each of the snapshot's values, front to back.
+	param:	snapshot	struct LinkedListSnapshot ptr
+	param:	visit		called with each value and ctx
+	param:	ctx			passed through to visit
+	pre: 	snapshot and visit are not null
+ */
+void linkedListSnapshotForEach(struct LinkedListSnapshot* snapshot, void (*visit)(TYPE value, void* ctx), void* ctx)
+{
+	assert(snapshot != 0);
+	assert(visit != 0);
+	for (int i = 0; i < snapshot->size; i++)
+	{
+		visit(snapshot->values[i], ctx);
+	}
+}
+
+/**
+	Releases a snapshot.
+	param:	snapshot	struct LinkedListSnapshot ptr
+	pre: 	snapshot is not null
+	post:	snapshot is freed
+ */
+void linkedListSnapshotRelease(struct LinkedListSnapshot* snapshot)
+{
+	assert(snapshot != 0);
+	free(snapshot);
+}
+
+/**
+	Reports bloom filter counters; this implementation has no bloom
+	filter, so they are all zero.
+	param:	bag		struct LinkedList ptr
+	param:	stats	receives the counters
+	pre: 	bag and stats are not null
+ */
+void linkedListBloomStats(struct LinkedList* bag, struct LinkedListBloomStats* stats)
+{
+	assert(bag != 0);
+	assert(stats != 0);
+	memset(stats, 0, sizeof(*stats));
+}
+
+/**
+	Returns the number of nodes visited by the bag's lookup scans
+	(linkedListContains/linkedListRemove) since it was created.
+	param:	bag		struct LinkedList ptr
+	pre: 	bag is not null
+	ret:	total nodes compared against a searched-for value
+ */
+long linkedListProbeCount(struct LinkedList* bag)
+{
+	assert(bag != 0);
+	return bag->probes;
+}
+
+/**
+	Writes the list to a binary image file in the same format as
+	linkedList.c: a struct ListImage header followed by the values
+	from front to back.
+	param:	list	struct LinkedList ptr
+	param:	path	file to create or overwrite
+	pre: 	list and path are not null
+	post:	file holds the list's image on success
+	ret:	0 on success, -1 if the file could not be written
+ */
+int linkedListSave(struct LinkedList* list, const char* path)
+{
+	assert(list != 0);
+	assert(path != 0);
+
+	FILE* file = fopen(path, "wb");
+	if (file == 0)
+	{
+		return -1;
+	}
+
+	struct ListImage header = { IMAGE_MAGIC, IMAGE_VERSION, sizeof(TYPE), 0, (uint64_t)list->size };
+	int ok = fwrite(&header, sizeof(header), 1, file) == 1;
+
+	TYPE buffer[IMAGE_IO_VALUES];
+	int buffered = 0;
+	for (uint32_t i = list->nodes[FRONT].next; ok && i != BACK; i = list->nodes[i].next)
+	{
+		buffer[buffered++] = list->nodes[i].value;
+		if (buffered == IMAGE_IO_VALUES)
+		{
+			ok = fwrite(buffer, sizeof(TYPE), buffered, file) == (size_t)buffered;
+			buffered = 0;
+		}
+	}
+	if (ok && buffered > 0)
+	{
+		ok = fwrite(buffer, sizeof(TYPE), buffered, file) == (size_t)buffered;
+	}
+
+	if (fclose(file) != 0)
+	{
+		ok = 0;
+	}
+	return ok ? 0 : -1;
+}
+
+/**
+	Creates a list from a binary image written by linkedListSave,
+	sizing the node array for the image's values up front.
+	param:	path	image file
+	pre: 	path is not null
+	ret:	new list holding the image's values front to back, or NULL
+			if the file cannot be read, is not a valid image for
+			this build's TYPE, or is not exactly as long as its
+			header says
+ */
+struct LinkedList* linkedListLoad(const char* path)
+{
+	assert(path != 0);
+
+	FILE* file = fopen(path, "rb");
+	if (file == 0)
+	{
+		return 0;
+	}
+
+	struct ListImage header;
+	if (fread(&header, sizeof(header), 1, file) != 1 || header.magic != IMAGE_MAGIC
+		|| header.version != IMAGE_VERSION || header.valueSize != sizeof(TYPE)
+		|| header.count > INT32_MAX - 2)
+	{
+		fclose(file);
+		return 0;
+	}
+
+	/* check the length before sizing the node array from count */
+	struct stat st;
+	if (fstat(fileno(file), &st) != 0
+		|| (uint64_t)st.st_size != sizeof(header) + header.count * sizeof(TYPE))
+	{
+		fclose(file);
+		return 0;
+	}
+
+	int count = (int)header.count;
+	struct LinkedList* list = linkedListCreateWithCapacity(count);
+	TYPE buffer[IMAGE_IO_VALUES];
+	while (list->size < count)
+	{
+		int want = (count - list->size < IMAGE_IO_VALUES) ? count - list->size : IMAGE_IO_VALUES;
+		if (fread(buffer, sizeof(TYPE), (size_t)want, file) != (size_t)want)
+		{
+			break;
+		}
+		linkedListAddBackN(list, buffer, want);
+	}
+
+	/* the file must hold exactly count values */
+	if (list->size != count || fgetc(file) != EOF)
+	{
+		linkedListDestroy(list);
+		list = 0;
+	}
+	fclose(file);
+	return list;
+}
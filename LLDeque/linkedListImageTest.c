@@ -0,0 +1,128 @@
+/***********************************************************
+* Filename: linkedListImageTest.c
+*
+* Overview:
+*   Tests for linkedListSave and linkedListLoad, built against
+*	each implementation that has them (linkedList.c and
+*	linkedListCompact.c); build and run with
+*		make -f makefileLLDequeBag test
+*
+*	- round trip: a saved list loads back with the same values
+*	- corrupt images: a header whose count is larger than the
+*	  file, a truncated file and a file with trailing bytes all
+*	  load as NULL, without sizing a list from the count first
+************************************************************/
+#include "linkedList.h"
+#include <assert.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#define IMAGE_PATH "linkedListImageTest.img"
+
+/* byte offset of the uint64_t count in struct ListImage */
+#define IMAGE_COUNT_OFFSET 16
+
+/**
+	Overwrites the count field of the image at IMAGE_PATH.
+ */
+static void writeImageCount(uint64_t count)
+{
+	FILE* file = fopen(IMAGE_PATH, "r+b");
+	assert(file != 0);
+	assert(fseek(file, IMAGE_COUNT_OFFSET, SEEK_SET) == 0);
+	assert(fwrite(&count, sizeof(count), 1, file) == 1);
+	assert(fclose(file) == 0);
+}
+
+/**
+	Copies the first size bytes of the image at IMAGE_PATH over it,
+	or appends size bytes past its end if size is longer.
+ */
+static void resizeImage(long size)
+{
+	FILE* file = fopen(IMAGE_PATH, "rb");
+	assert(file != 0);
+	char* bytes = calloc((size_t)size, 1);
+	size_t got = fread(bytes, 1, (size_t)size, file);
+	fclose(file);
+	(void)got;
+
+	file = fopen(IMAGE_PATH, "wb");
+	assert(file != 0);
+	assert(fwrite(bytes, 1, (size_t)size, file) == (size_t)size);
+	assert(fclose(file) == 0);
+	free(bytes);
+}
+
+/**
+	Saves 0, 1, ..., n - 1 to IMAGE_PATH and returns the file's length.
+ */
+static long saveRange(int n)
+{
+	struct LinkedList* list = linkedListCreate();
+	for (int i = 0; i < n; i++)
+	{
+		linkedListAddBack(list, (TYPE)i);
+	}
+	assert(linkedListSave(list, IMAGE_PATH) == 0);
+	linkedListDestroy(list);
+
+	FILE* file = fopen(IMAGE_PATH, "rb");
+	assert(file != 0);
+	fseek(file, 0, SEEK_END);
+	long size = ftell(file);
+	fclose(file);
+	return size;
+}
+
+static void testRoundTrip()
+{
+	saveRange(1000);
+	struct LinkedList* list = linkedListLoad(IMAGE_PATH);
+	assert(list != 0);
+	for (int i = 0; i < 1000; i++)
+	{
+		assert(linkedListFront(list) == (TYPE)i);
+		linkedListRemoveFront(list);
+	}
+	assert(linkedListIsEmpty(list));
+	linkedListDestroy(list);
+}
+
+static void testCorruptImages()
+{
+	/* header only, with a count far beyond what the file holds */
+	saveRange(0);
+	writeImageCount((uint64_t)INT32_MAX - 600);
+	assert(linkedListLoad(IMAGE_PATH) == 0);
+
+	/* a count one larger than the values written */
+	saveRange(100);
+	writeImageCount(101);
+	assert(linkedListLoad(IMAGE_PATH) == 0);
+
+	/* truncated in the middle of a value */
+	long size = saveRange(100);
+	resizeImage(size - 1);
+	assert(linkedListLoad(IMAGE_PATH) == 0);
+
+	/* truncated inside the header */
+	resizeImage(8);
+	assert(linkedListLoad(IMAGE_PATH) == 0);
+
+	/* trailing bytes after the last value */
+	size = saveRange(100);
+	resizeImage(size + (long)sizeof(TYPE));
+	assert(linkedListLoad(IMAGE_PATH) == 0);
+
+	remove(IMAGE_PATH);
+}
+
+int main()
+{
+	testRoundTrip();
+	testCorruptImages();
+	printf("all image tests passed\n");
+	return 0;
+}
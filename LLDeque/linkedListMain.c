@@ -26,7 +26,16 @@ int main(){
        linkedListAdd(k, (TYPE)14);
        linkedListRemove(k, (TYPE)11);
         linkedListPrint(k);
+#ifdef LINKED_LIST_STATS
+        linkedListStatsDump(k, stdout);
+#endif
         linkedListDestroy(k);
+#ifdef LINKED_LIST_STATS
+        struct LinkedListStats totals;
+        linkedListStatsDestroyed(&totals);
+        printf("%ld lists created, %ld destroyed\n", totals.calls[LINKED_LIST_OP_CREATE],
+                totals.calls[LINKED_LIST_OP_DESTROY]);
+#endif
 
 /* validate both lists are empty */
 		//assert(linkedListIsEmpty(l));
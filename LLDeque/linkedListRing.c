@@ -0,0 +1,381 @@
+/***********************************************************
+* Filename: linkedListRing.c
+*
+* Overview:
+*   This program is an array implementation of the deque and
+*	bag ADTs declared in linkedList.h, for pure deque workloads
+*	that never need stable link addresses. It is a drop-in
+*	replacement for linkedList.c, selected at build time with:
+*		make -f makefileLLDequeBag LIST_IMPL=linkedListRing
+*
+*	The values live in one circular array whose capacity is a
+*	power of 2, so positions wrap with a mask instead of a
+*	division. The front is at index start and the back at
+*	(start + size - 1) & mask. A full array doubles (the values
+*	are copied out in order, front first); with RING_SHRINK
+*	set, an array at most a quarter full halves, down to
+*	RING_MIN_CAPACITY. Either way each deque operation is
+*	amortized O(1) with no allocation per value.
+*
+*	Bag removal shifts the shorter side of the array over the
+*	removed value. Note that the capacity hint sizes the first
+*	array; the LINKED_LIST_* flags are accepted for API
+*	compatibility but have no effect.
+************************************************************/
+#include "linkedList.h"
+#include <assert.h>
+#include <stdlib.h>
+#include <stdio.h>
+
+#ifndef FORMAT_SPECIFIER
+#define FORMAT_SPECIFIER "%d"
+#endif
+
+/* smallest array capacity (power of 2) */
+#ifndef RING_MIN_CAPACITY
+#define RING_MIN_CAPACITY 16
+#endif
+
+/* nonzero to halve the array when it is at most a quarter full */
+#ifndef RING_SHRINK
+#define RING_SHRINK 1
+#endif
+
+// Circular array of size values starting at values[start]
+struct LinkedList
+{
+	TYPE* values;
+	int capacity;		// power of 2
+	int start;			// index of the front value
+	int size;
+};
+
+/**
+	Returns the array index of the value at position i from the front.
+	param: 	list 	struct LinkedList ptr
+	param:	i		position, 0 <= i < capacity
+ */
+static int slot(struct LinkedList* list, int i)
+{
+	return (list->start + i) & (list->capacity - 1);
+}
+
+/**
+	Moves the values into a new array of the given capacity, with the
+	front value at index 0.
+	param: 	list 	struct LinkedList ptr
+	param:	capacity	power of 2 no smaller than size
+ */
+static void resize(struct LinkedList* list, int capacity)
+{
+	assert(capacity >= list->size);
+
+	TYPE* values = malloc((size_t)capacity * sizeof(TYPE));
+	assert(values != 0);
+
+	/* the values wrap at most once: copy the part up to the array's end, then the rest */
+	int first = list->capacity - list->start;
+	if (first > list->size)
+	{
+		first = list->size;
+	}
+	for (int i = 0; i < first; i++)
+	{
+		values[i] = list->values[list->start + i];
+	}
+	for (int i = first; i < list->size; i++)
+	{
+		values[i] = list->values[i - first];
+	}
+
+	free(list->values);
+	list->values = values;
+	list->capacity = capacity;
+	list->start = 0;
+}
+
+/**
+	Makes room for one more value, doubling a full array.
+	param: 	list 	struct LinkedList ptr
+ */
+static void grow(struct LinkedList* list)
+{
+	if (list->size == list->capacity)
+	{
+		assert(list->capacity <= (1 << 29));
+		resize(list, list->capacity * 2);
+	}
+}
+
+/**
+	Halves an array that is at most a quarter full, if RING_SHRINK
+	is set and it is larger than RING_MIN_CAPACITY. Waiting until a
+	quarter (rather than half) keeps alternating adds and removes at
+	a boundary from resizing every time.
+	param: 	list 	struct LinkedList ptr
+ */
+static void shrink(struct LinkedList* list)
+{
+	if (RING_SHRINK && list->capacity > RING_MIN_CAPACITY && list->size <= list->capacity / 4)
+	{
+		resize(list, list->capacity / 2);
+	}
+}
+
+/**
+	Allocates and initializes a list.
+	pre: 	none
+	post: 	memory allocated for new struct LinkedList ptr
+	return: list
+ */
+struct LinkedList* linkedListCreate()
+{
+	return linkedListCreateWithCapacity(0);
+}
+
+/**
+	Allocates and initializes a list whose array holds at least
+	capacity values before it first grows.
+	param:	capacity	expected number of values
+	return: list
+ */
+struct LinkedList* linkedListCreateWithCapacity(int capacity)
+{
+	struct LinkedList* list = malloc(sizeof(struct LinkedList));
+	assert(list != 0);
+
+	list->capacity = RING_MIN_CAPACITY;
+	while (list->capacity < capacity)
+	{
+		assert(list->capacity <= (1 << 29));
+		list->capacity *= 2;
+	}
+	list->values = malloc((size_t)list->capacity * sizeof(TYPE));
+	assert(list->values != 0);
+	list->start = 0;
+	list->size = 0;
+	return list;
+}
+
+/**
+	Allocates and initializes a list; the flags are ignored.
+	param:	capacity	expected number of values
+	param:	flags		bitwise or of LINKED_LIST_* flags
+	return: list
+ */
+struct LinkedList* linkedListCreateWithFlags(int capacity, int flags)
+{
+	(void)flags;
+	return linkedListCreateWithCapacity(capacity);
+}
+
+/**
+	Frees the list's array and the list itself.
+	param:	list 	struct LinkedList ptr
+	pre: 	list is not null
+ */
+void linkedListDestroy(struct LinkedList* list)
+{
+	assert(list != NULL);
+	free(list->values);
+	free(list);
+}
+
+/**
+	Adds a new value to the front of the deque.
+	param: 	deque 	struct LinkedList ptr
+	param: 	value 	TYPE
+	pre: 	deque is not null
+	post: 	value is the deque's front
+ */
+void linkedListAddFront(struct LinkedList* deque, TYPE value)
+{
+	assert(deque != 0);
+	grow(deque);
+	deque->start = (deque->start - 1) & (deque->capacity - 1);
+	deque->values[deque->start] = value;
+	deque->size += 1;
+}
+
+/**
+	Adds a new value to the back of the deque.
+	param: 	deque 	struct LinkedList ptr
+	param: 	value 	TYPE
+	pre: 	deque is not null
+	post: 	value is the deque's back
+ */
+void linkedListAddBack(struct LinkedList* deque, TYPE value)
+{
+	assert(deque != 0);
+	grow(deque);
+	deque->values[slot(deque, deque->size)] = value;
+	deque->size += 1;
+}
+
+/**
+	Returns the value at the front of the deque.
+	param: 	deque 	struct LinkedList ptr
+	pre: 	deque is not null and not empty
+	ret: 	the front value
+ */
+TYPE linkedListFront(struct LinkedList* deque)
+{
+	assert(deque != 0);
+	assert(!linkedListIsEmpty(deque));
+	return deque->values[deque->start];
+}
+
+/**
+	Returns the value at the back of the deque.
+	param: 	deque 	struct LinkedList ptr
+	pre: 	deque is not null and not empty
+	ret: 	the back value
+ */
+TYPE linkedListBack(struct LinkedList* deque)
+{
+	assert(deque != 0);
+	assert(!linkedListIsEmpty(deque));
+	return deque->values[slot(deque, deque->size - 1)];
+}
+
+/**
+	Removes the value at the front of the deque.
+	param: 	deque 	struct LinkedList ptr
+	pre: 	deque is not null and not empty
+	post: 	array may have halved (RING_SHRINK)
+ */
+void linkedListRemoveFront(struct LinkedList* deque)
+{
+	assert(deque != 0);
+	assert(!linkedListIsEmpty(deque));
+	deque->start = slot(deque, 1);
+	deque->size -= 1;
+	shrink(deque);
+}
+
+/**
+	Removes the value at the back of the deque.
+	param: 	deque 	struct LinkedList ptr
+	pre: 	deque is not null and not empty
+	post: 	array may have halved (RING_SHRINK)
+ */
+void linkedListRemoveBack(struct LinkedList* deque)
+{
+	assert(deque != 0);
+	assert(!linkedListIsEmpty(deque));
+	deque->size -= 1;
+	shrink(deque);
+}
+
+/**
+	Returns 1 if the deque is empty and 0 otherwise.
+	param:	deque	struct LinkedList ptr
+	pre:	deque is not null
+	ret:	1 if its size is 0 (empty), otherwise 0 (not empty)
+ */
+int linkedListIsEmpty(struct LinkedList* deque)
+{
+	assert(deque != 0);
+	return deque->size == 0;
+}
+
+/**
+	Prints the values in the deque from front to back.
+	param:	deque	struct LinkedList ptr
+	pre:	deque is not null
+	ret:	outputs to the console the values from front to back;
+			if empty, prints msg that is empty
+ */
+void linkedListPrint(struct LinkedList* deque)
+{
+	assert(deque != 0);
+
+	if (linkedListIsEmpty(deque))
+	{
+		printf("Deque's list is empty...\n");
+		return;
+	}
+
+	printf("Printing the deque's list of values...\n");
+	for (int i = 0; i < deque->size; i++)
+	{
+		printf(FORMAT_SPECIFIER " ", deque->values[slot(deque, i)]);
+	}
+	printf("\n");
+}
+
+/**
+	Adds a value to the bag (at the front).
+	param:	bag		struct LinkedList ptr
+	param: 	value 	TYPE
+	pre: 	bag is not null
+ */
+void linkedListAdd(struct LinkedList* bag, TYPE value)
+{
+	linkedListAddFront(bag, value);
+}
+
+/**
+	Finds the first occurrence of a value in the bag.
+	param:	bag		struct LinkedList ptr
+	param: 	value 	TYPE
+	pre: 	bag is not null
+	ret:	position of the value from the front, or -1 if not found
+ */
+static int findValue(struct LinkedList* bag, TYPE value)
+{
+	for (int i = 0; i < bag->size; i++)
+	{
+		if (EQ(bag->values[slot(bag, i)], value))
+		{
+			return i;
+		}
+	}
+	return -1;
+}
+
+/**
+	Returns 1 if the value is in the bag and 0 otherwise.
+	param:	bag		struct LinkedList ptr
+	param: 	value 	TYPE
+	pre: 	bag is not null
+	ret:	1 if value found; otherwise, 0
+ */
+int linkedListContains(struct LinkedList* bag, TYPE value)
+{
+	assert(bag != 0);
+	return findValue(bag, value) >= 0;
+}
+
+/**
+	Removes the first occurrence of the value, closing the gap by
+	shifting whichever side of it is shorter.
+	param:	bag		struct LinkedList ptr
+	param: 	value 	TYPE
+	pre: 	bag is not null
+	post:	if value found, one occurrence is removed
+ */
+void linkedListRemove(struct LinkedList* bag, TYPE value)
+{
+	assert(bag != 0);
+
+	int pos = findValue(bag, value);
+	if (pos < 0)
+	{
+		return;
+	}
+
+	if (pos < bag->size - 1 - pos)
+	{
+		for (int i = pos; i > 0; i--)
+			bag->values[slot(bag, i)] = bag->values[slot(bag, i - 1)];
+		bag->start = slot(bag, 1);
+	}
+	else
+	{
+		for (int i = pos; i < bag->size - 1; i++)
+			bag->values[slot(bag, i)] = bag->values[slot(bag, i + 1)];
+	}
+	bag->size -= 1;
+	shrink(bag);
+}
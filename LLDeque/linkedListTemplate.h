@@ -0,0 +1,267 @@
+#ifndef LINKED_LIST_TEMPLATE_H
+#define LINKED_LIST_TEMPLATE_H
+
+/***********************************************************
+* Filename: linkedListTemplate.h
+*
+* Overview:
+*   Macro template for type-specialized linked list deques and
+*	bags. linkedList.h fixes one TYPE per build; this header
+*	instead generates a separate, name-prefixed list for each
+*	element type, so one program can hold e.g. an int deque, a
+*	double deque and a deque of structs:
+*
+*		LINKED_LIST_DEFINE(LinkedList_int, linkedListInt, int,
+*			LINKED_LIST_LT, LINKED_LIST_EQ, LINKED_LIST_PRINT_INT)
+*
+*	defines struct LinkedList_int and the functions
+*	linkedListIntCreate, linkedListIntAddBack, ... with the same
+*	behavior as their linkedList.h counterparts, including a
+*	stable merge sort by LT (linkedListIntSort). The comparators
+*	and formatter are macros expanded into each function, and
+*	every function is static inline, so the compiler specializes
+*	the hot loops for the element type.
+*
+*	Comparators take two values: LT(A, B), EQ(A, B).
+*	The formatter takes a FILE* and a value: PRINT(OUT, A).
+*
+*	Note that, like linkedList.c, each list has a front and a
+*	back sentinel; here they are embedded in the list struct.
+************************************************************/
+#include <assert.h>
+#include <stdlib.h>
+#include <stdio.h>
+
+/* comparators for arithmetic element types */
+#define LINKED_LIST_LT(A, B) ((A) < (B))
+#define LINKED_LIST_EQ(A, B) ((A) == (B))
+
+/* formatters for common element types */
+#define LINKED_LIST_PRINT_INT(OUT, A) fprintf((OUT), "%d ", (A))
+#define LINKED_LIST_PRINT_DOUBLE(OUT, A) fprintf((OUT), "%g ", (A))
+
+#define LINKED_LIST_DEFINE(NAME, PREFIX, T, LT, EQ, PRINT)						\
+																				\
+struct NAME##Link																\
+{																				\
+	T value;																	\
+	struct NAME##Link* next;													\
+	struct NAME##Link* prev;													\
+};																				\
+																				\
+struct NAME																		\
+{																				\
+	struct NAME##Link frontSentinel;											\
+	struct NAME##Link backSentinel;												\
+	int size;																	\
+};																				\
+																				\
+static inline struct NAME* PREFIX##Create(void)									\
+{																				\
+	struct NAME* list = malloc(sizeof(struct NAME));							\
+	assert(list != 0);															\
+	list->frontSentinel.next = &list->backSentinel;								\
+	list->frontSentinel.prev = NULL;											\
+	list->backSentinel.prev = &list->frontSentinel;								\
+	list->backSentinel.next = NULL;												\
+	list->size = 0;																\
+	return list;																\
+}																				\
+																				\
+static inline void PREFIX##AddLinkBefore(struct NAME* list,						\
+	struct NAME##Link* link, T value)											\
+{																				\
+	struct NAME##Link* node = malloc(sizeof(struct NAME##Link));				\
+	assert(node != 0);															\
+	node->value = value;														\
+	node->next = link;															\
+	node->prev = link->prev;													\
+	link->prev->next = node;													\
+	link->prev = node;															\
+	list->size += 1;															\
+}																				\
+																				\
+static inline void PREFIX##RemoveLink(struct NAME* list,						\
+	struct NAME##Link* link)													\
+{																				\
+	assert(link != &list->frontSentinel && link != &list->backSentinel);		\
+	link->prev->next = link->next;												\
+	link->next->prev = link->prev;												\
+	free(link);																	\
+	list->size -= 1;															\
+}																				\
+																				\
+static inline int PREFIX##IsEmpty(struct NAME* list)							\
+{																				\
+	assert(list != 0);															\
+	return list->size == 0;														\
+}																				\
+																				\
+static inline void PREFIX##Destroy(struct NAME* list)							\
+{																				\
+	assert(list != 0);															\
+	while (!PREFIX##IsEmpty(list))												\
+	{																			\
+		PREFIX##RemoveLink(list, list->frontSentinel.next);						\
+	}																			\
+	free(list);																	\
+}																				\
+																				\
+static inline void PREFIX##AddFront(struct NAME* list, T value)					\
+{																				\
+	assert(list != 0);															\
+	PREFIX##AddLinkBefore(list, list->frontSentinel.next, value);				\
+}																				\
+																				\
+static inline void PREFIX##AddBack(struct NAME* list, T value)					\
+{																				\
+	assert(list != 0);															\
+	PREFIX##AddLinkBefore(list, &list->backSentinel, value);					\
+}																				\
+																				\
+static inline T PREFIX##Front(struct NAME* list)								\
+{																				\
+	assert(list != 0 && list->size > 0);										\
+	return list->frontSentinel.next->value;										\
+}																				\
+																				\
+static inline T PREFIX##Back(struct NAME* list)									\
+{																				\
+	assert(list != 0 && list->size > 0);										\
+	return list->backSentinel.prev->value;										\
+}																				\
+																				\
+static inline void PREFIX##RemoveFront(struct NAME* list)						\
+{																				\
+	assert(list != 0 && list->size > 0);										\
+	PREFIX##RemoveLink(list, list->frontSentinel.next);							\
+}																				\
+																				\
+static inline void PREFIX##RemoveBack(struct NAME* list)						\
+{																				\
+	assert(list != 0 && list->size > 0);										\
+	PREFIX##RemoveLink(list, list->backSentinel.prev);							\
+}																				\
+																				\
+static inline void PREFIX##Print(struct NAME* list, FILE* out)					\
+{																				\
+	assert(list != 0);															\
+	if (PREFIX##IsEmpty(list))													\
+	{																			\
+		fprintf(out, "Deque's list is empty...\n");								\
+		return;																	\
+	}																			\
+	fprintf(out, "Printing the deque's list of values...\n");					\
+	for (struct NAME##Link* link = list->frontSentinel.next;					\
+		link != &list->backSentinel; link = link->next)							\
+	{																			\
+		PRINT(out, link->value);												\
+	}																			\
+	fprintf(out, "\n");															\
+}																				\
+																				\
+static inline struct NAME##Link* PREFIX##MergeChains(struct NAME##Link* left,	\
+	struct NAME##Link* right)													\
+{																				\
+	struct NAME##Link head;														\
+	struct NAME##Link* tail = &head;											\
+	while (left != 0 && right != 0)												\
+	{																			\
+		if (LT(right->value, left->value))										\
+		{																		\
+			tail->next = right;													\
+			right = right->next;												\
+		}																		\
+		else																	\
+		{																		\
+			tail->next = left;													\
+			left = left->next;													\
+		}																		\
+		tail = tail->next;														\
+	}																			\
+	tail->next = (left != 0) ? left : right;									\
+	return head.next;															\
+}																				\
+																				\
+static inline void PREFIX##Sort(struct NAME* list)								\
+{																				\
+	assert(list != 0);															\
+	if (list->size < 2)															\
+	{																			\
+		return;																	\
+	}																			\
+	struct NAME##Link* bins[sizeof(int) * 8 + 1] = { 0 };						\
+	int maxBin = 0;																\
+	struct NAME##Link* link = list->frontSentinel.next;							\
+	list->backSentinel.prev->next = 0;											\
+	while (link != 0)															\
+	{																			\
+		struct NAME##Link* carry = link;										\
+		link = link->next;														\
+		carry->next = 0;														\
+		int i = 0;																\
+		while (bins[i] != 0)													\
+		{																		\
+			carry = PREFIX##MergeChains(bins[i], carry);						\
+			bins[i] = 0;														\
+			i++;																\
+		}																		\
+		bins[i] = carry;														\
+		if (i > maxBin)															\
+		{																		\
+			maxBin = i;															\
+		}																		\
+	}																			\
+	struct NAME##Link* head = 0;												\
+	for (int i = 0; i <= maxBin; i++)											\
+	{																			\
+		if (bins[i] != 0)														\
+		{																		\
+			head = (head == 0) ? bins[i] : PREFIX##MergeChains(bins[i], head);	\
+		}																		\
+	}																			\
+	struct NAME##Link* prev = &list->frontSentinel;								\
+	for (link = head; link != 0; link = link->next)								\
+	{																			\
+		prev->next = link;														\
+		link->prev = prev;														\
+		prev = link;															\
+	}																			\
+	prev->next = &list->backSentinel;											\
+	list->backSentinel.prev = prev;												\
+}																				\
+																				\
+static inline void PREFIX##Add(struct NAME* bag, T value)						\
+{																				\
+	PREFIX##AddFront(bag, value);												\
+}																				\
+																				\
+static inline struct NAME##Link* PREFIX##FindLink(struct NAME* bag, T value)	\
+{																				\
+	assert(bag != 0);															\
+	for (struct NAME##Link* link = bag->frontSentinel.next;						\
+		link != &bag->backSentinel; link = link->next)							\
+	{																			\
+		if (EQ(link->value, value))												\
+		{																		\
+			return link;														\
+		}																		\
+	}																			\
+	return 0;																	\
+}																				\
+																				\
+static inline int PREFIX##Contains(struct NAME* bag, T value)					\
+{																				\
+	return PREFIX##FindLink(bag, value) != 0;									\
+}																				\
+																				\
+static inline void PREFIX##Remove(struct NAME* bag, T value)					\
+{																				\
+	struct NAME##Link* link = PREFIX##FindLink(bag, value);						\
+	if (link != 0)																\
+	{																			\
+		PREFIX##RemoveLink(bag, link);											\
+	}																			\
+}
+
+#endif
@@ -0,0 +1,57 @@
+#include "linkedListTemplate.h"
+#include <stdio.h>
+#include <assert.h>
+
+struct Point
+{
+	int x;
+	int y;
+};
+
+#define POINT_LT(A, B) ((A).x < (B).x || ((A).x == (B).x && (A).y < (B).y))
+#define POINT_EQ(A, B) ((A).x == (B).x && (A).y == (B).y)
+#define POINT_PRINT(OUT, A) fprintf((OUT), "(%d, %d) ", (A).x, (A).y)
+
+LINKED_LIST_DEFINE(LinkedList_int, linkedListInt, int, LINKED_LIST_LT, LINKED_LIST_EQ, LINKED_LIST_PRINT_INT)
+LINKED_LIST_DEFINE(LinkedList_double, linkedListDouble, double, LINKED_LIST_LT, LINKED_LIST_EQ, LINKED_LIST_PRINT_DOUBLE)
+LINKED_LIST_DEFINE(LinkedList_point, linkedListPoint, struct Point, POINT_LT, POINT_EQ, POINT_PRINT)
+
+int main(){
+	/* DEQUES of three element types in one program */
+	struct LinkedList_int* ints = linkedListIntCreate();
+	linkedListIntAddFront(ints, 1);
+	linkedListIntAddBack(ints, 2);
+	linkedListIntAddFront(ints, 3);
+	linkedListIntPrint(ints, stdout);
+	printf("%d\n", linkedListIntFront(ints));
+	printf("%d\n", linkedListIntBack(ints));
+	linkedListIntSort(ints);
+	assert(linkedListIntFront(ints) == 1 && linkedListIntBack(ints) == 3);
+	linkedListIntDestroy(ints);
+
+	struct LinkedList_double* doubles = linkedListDoubleCreate();
+	linkedListDoubleAddBack(doubles, 1.5);
+	linkedListDoubleAddBack(doubles, 2.25);
+	linkedListDoubleRemoveFront(doubles);
+	linkedListDoublePrint(doubles, stdout);
+	linkedListDoubleDestroy(doubles);
+
+/* BAG */
+
+	struct LinkedList_point* points = linkedListPointCreate();
+	struct Point a = { 1, 2 };
+	struct Point b = { 3, 4 };
+	struct Point c = { 1, 0 };
+	linkedListPointAdd(points, a);
+	linkedListPointAdd(points, b);
+	linkedListPointAdd(points, c);
+	linkedListPointSort(points);
+	assert(POINT_EQ(linkedListPointFront(points), c));
+	linkedListPointRemove(points, a);
+	assert(!linkedListPointContains(points, a));
+	assert(linkedListPointContains(points, b));
+	linkedListPointPrint(points, stdout);
+	linkedListPointDestroy(points);
+
+	return 0;
+}
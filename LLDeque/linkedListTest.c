@@ -0,0 +1,353 @@
+/***********************************************************
+* Filename: linkedListTest.c
+*
+* Overview:
+*   Tests for the parts of linkedList.c whose behavior is not
+*	visible from linkedListMain.c's demo. Each test asserts its
+*	expectations and main runs them all; build and run with
+*		make -f makefileLLDequeBag test
+*	(the target builds with -fsanitize=address,undefined, so
+*	use-after-free and leaks fail the run as well).
+*
+*	- pool: lists that concat or split share one pool, whose
+*	  slabs outlive any one of the lists and are freed with
+*	  the last of them
+*	- hashed bags: repeated values share one index slot, and
+*	  removing them one by one or all at once keeps the index
+*	  in step with the links
+*	- snapshots: random changes to a list never change what
+*	  its live snapshots read
+************************************************************/
+#include "linkedList.h"
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+// Allocator that tracks how many bytes are outstanding
+struct CountingAllocator
+{
+	long bytes;
+	long blocks;
+};
+
+static void* countingAlloc(void* context, size_t size)
+{
+	struct CountingAllocator* counter = context;
+	counter->bytes += (long)size;
+	counter->blocks += 1;
+	return malloc(size);
+}
+
+static void countingFree(void* context, void* ptr, size_t size)
+{
+	struct CountingAllocator* counter = context;
+	counter->bytes -= (long)size;
+	counter->blocks -= 1;
+	free(ptr);
+}
+
+/**
+	Asserts that the list holds first, first + 1, ..., first + n - 1
+	from front to back.
+ */
+static void assertRange(struct LinkedList* list, int first, int n)
+{
+	TYPE* values = malloc((size_t)(n > 0 ? n : 1) * sizeof(TYPE));
+	assert(linkedListRemoveFrontN(list, values, n + 1) == n);
+	for (int i = 0; i < n; i++)
+	{
+		assert(values[i] == (TYPE)(first + i));
+	}
+	linkedListAddBackN(list, values, n);
+	free(values);
+}
+
+/**
+	A list split off another keeps its links after the original is
+	destroyed, and the shared slabs are freed with the last list.
+ */
+static void testPoolSplitLifetime()
+{
+	struct CountingAllocator counter = { 0, 0 };
+	struct Allocator allocator = { countingAlloc, countingFree, &counter };
+
+	struct LinkedList* list = linkedListCreateWithAllocator(0, 0, &allocator);
+	for (int i = 0; i < 10000; i++)
+	{
+		linkedListAddBack(list, (TYPE)i);
+	}
+	struct LinkedList* tail = linkedListSplitAt(list, 9990);
+	struct LinkedList* rest = linkedListSplitAt(tail, 5);
+
+	/* a small survivor pins every slab of the shared pool */
+	long slabs = counter.bytes;
+	linkedListDestroy(list);
+	assert(counter.bytes > 10000 * (long)sizeof(TYPE));
+	assert(counter.bytes < slabs);
+
+	assertRange(tail, 9990, 5);
+	assertRange(rest, 9995, 5);
+
+	/* links freed by one list are reused by the other */
+	linkedListRemoveFrontN(tail, 0, 5);
+	long before = counter.bytes;
+	for (int i = 0; i < 5; i++)
+	{
+		linkedListAddBack(rest, (TYPE)(10000 + i));
+	}
+	assert(counter.bytes == before);
+	assertRange(rest, 9995, 10);
+
+	linkedListDestroy(rest);
+	assert(counter.bytes > 0);
+	linkedListDestroy(tail);
+	assert(counter.bytes == 0 && counter.blocks == 0);
+}
+
+/**
+	Concatenated lists merge their pools; either may be destroyed
+	first, and nothing is freed twice or leaked.
+ */
+static void testPoolConcatLifetime()
+{
+	for (int order = 0; order < 2; order++)
+	{
+		struct CountingAllocator counter = { 0, 0 };
+		struct Allocator allocator = { countingAlloc, countingFree, &counter };
+
+		struct LinkedList* a = linkedListCreateWithAllocator(4, 0, &allocator);
+		struct LinkedList* b = linkedListCreateWithAllocator(4, 0, &allocator);
+		struct LinkedList* c = linkedListCreateWithAllocator(4, 0, &allocator);
+		for (int i = 0; i < 100; i++)
+		{
+			linkedListAddBack(a, (TYPE)i);
+			linkedListAddBack(b, (TYPE)(100 + i));
+			linkedListAddBack(c, (TYPE)(200 + i));
+		}
+
+		/* b's pool merges into a's, then c's into the merged one */
+		linkedListConcat(a, b);
+		linkedListConcat(b, c);
+		assert(linkedListIsEmpty(c));
+		assertRange(a, 0, 200);
+		assertRange(b, 200, 100);
+
+		if (order == 0)
+		{
+			linkedListDestroy(a);
+			assertRange(b, 200, 100);
+			linkedListDestroy(c);
+			assertRange(b, 200, 100);
+			linkedListDestroy(b);
+		}
+		else
+		{
+			linkedListDestroy(b);
+			linkedListDestroy(c);
+			assertRange(a, 0, 200);
+			linkedListDestroy(a);
+		}
+		assert(counter.bytes == 0 && counter.blocks == 0);
+	}
+}
+
+/**
+	A hashed bag holding many copies of a few values answers lookups
+	correctly while copies are removed from either end, by value and
+	all at once.
+ */
+static void testHashedDuplicates()
+{
+	struct LinkedList* bag = linkedListCreateWithFlags(0, LINKED_LIST_HASHED | LINKED_LIST_BLOOM);
+	int counts[3] = { 1000, 1000, 1000 };	// copies of 0, 4096 and 2 * 4096
+	for (int i = 0; i < 3000; i++)
+	{
+		linkedListAdd(bag, (TYPE)(i % 3 * 4096));
+	}
+
+	for (int i = 0; i < 500; i++)
+	{
+		counts[linkedListFront(bag) / 4096] -= 1;
+		linkedListRemoveFront(bag);
+		counts[linkedListBack(bag) / 4096] -= 1;
+		linkedListRemoveBack(bag);
+		linkedListRemove(bag, (TYPE)4096);
+		counts[1] -= 1;
+	}
+	assert(linkedListContains(bag, (TYPE)0));
+	assert(linkedListRemoveAll(bag, (TYPE)4096) == counts[1]);
+	assert(!linkedListContains(bag, (TYPE)4096));
+	assert(linkedListRemoveAll(bag, (TYPE)0) == counts[0]);
+	assert(linkedListRemoveAll(bag, (TYPE)(2 * 4096)) == counts[2]);
+	assert(linkedListIsEmpty(bag));
+
+	/* the emptied index takes the values again */
+	linkedListAdd(bag, (TYPE)0);
+	linkedListAdd(bag, (TYPE)0);
+	assert(linkedListRemoveAll(bag, (TYPE)0) == 2);
+	assert(!linkedListContains(bag, (TYPE)0));
+	linkedListDestroy(bag);
+}
+
+#define SNAPSHOT_TEST_MAX 4096
+
+// A live snapshot and the values it read when it was taken
+struct SnapshotModel
+{
+	struct LinkedListSnapshot* snapshot;
+	int size;
+	TYPE values[SNAPSHOT_TEST_MAX];
+};
+
+static void appendValue(TYPE value, void* ctx)
+{
+	struct SnapshotModel* model = ctx;
+	assert(model->size < SNAPSHOT_TEST_MAX);
+	model->values[model->size++] = value;
+}
+
+static int isOdd(TYPE value, void* ctx)
+{
+	(void)ctx;
+	return (int)value % 2 != 0;
+}
+
+/**
+	Asserts that the snapshot still reads the values it was taken with.
+ */
+static void assertSnapshot(struct SnapshotModel* model)
+{
+	struct SnapshotModel now;
+	now.size = 0;
+	linkedListSnapshotForEach(model->snapshot, appendValue, &now);
+	assert(now.size == model->size);
+	assert(linkedListSnapshotSize(model->snapshot) == model->size);
+	for (int i = 0; i < model->size; i++)
+	{
+		assert(now.values[i] == model->values[i]);
+	}
+}
+
+/**
+	Random changes of every kind, made while up to eight snapshots are
+	live, leave each snapshot reading the values it was taken with.
+	Runs with each flag so that the index, bloom filter and promotion
+	paths copy and retire links too.
+ */
+static void testSnapshotConsistency()
+{
+	static struct SnapshotModel models[8];
+	static const int flags[4] = { LINKED_LIST_HASHED, LINKED_LIST_MOVE_TO_FRONT, LINKED_LIST_BLOOM, 0 };
+	unsigned seed = 7;
+
+	for (int round = 0; round < 300; round++)
+	{
+		struct LinkedList* list = linkedListCreateWithFlags(0, flags[round % 4]);
+		int live = 0;
+
+		for (int i = 0; i < 400; i++)
+		{
+			seed = seed * 1103515245 + 12345;
+			TYPE value = (TYPE)((seed >> 16) % 100);
+			switch ((seed >> 8) % 15)
+			{
+			case 0:
+			case 1:
+				linkedListAddBack(list, value);
+				break;
+			case 2:
+				linkedListAddFront(list, value);
+				break;
+			case 3:
+				if (!linkedListIsEmpty(list))
+				{
+					linkedListRemoveFront(list);
+				}
+				break;
+			case 4:
+				if (!linkedListIsEmpty(list))
+				{
+					linkedListRemoveBack(list);
+				}
+				break;
+			case 5:
+				linkedListRemove(list, value);
+				break;
+			case 6:
+				linkedListContains(list, value);
+				break;
+			case 7:
+				if (live < 8)
+				{
+					models[live].snapshot = linkedListSnapshot(list);
+					models[live].size = 0;
+					linkedListSnapshotForEach(models[live].snapshot, appendValue, &models[live]);
+					live++;
+				}
+				break;
+			case 8:
+				if (live > 0)
+				{
+					int k = (int)((seed >> 3) % (unsigned)live);
+					linkedListSnapshotRelease(models[k].snapshot);
+					models[k] = models[--live];
+				}
+				break;
+			case 9:
+				linkedListRemoveFrontN(list, 0, 3);
+				linkedListRemoveBackN(list, 0, 2);
+				break;
+			case 10:
+				if (seed & 64)
+				{
+					linkedListSort(list);
+				}
+				else
+				{
+					linkedListRemoveIf(list, isOdd, 0);
+				}
+				break;
+			case 11:
+			{
+				struct LinkedList* tail = linkedListSplitAt(list, linkedListIsEmpty(list) ? 0 : 1);
+				struct LinkedListSnapshot* tailSnapshot = linkedListSnapshot(tail);
+				linkedListConcat(list, tail);
+				linkedListSnapshotRelease(tailSnapshot);
+				linkedListDestroy(tail);
+				break;
+			}
+			case 12:
+				linkedListRemoveAll(list, value);
+				break;
+			default:
+			{
+				TYPE values[3] = { value, value + 1, value + 2 };
+				linkedListAddBackN(list, values, 3);
+				break;
+			}
+			}
+
+			for (int k = 0; k < live; k++)
+			{
+				assertSnapshot(&models[k]);
+			}
+		}
+
+		while (live > 0)
+		{
+			linkedListSnapshotRelease(models[--live].snapshot);
+		}
+		linkedListAddBack(list, (TYPE)1);
+		linkedListDestroy(list);
+	}
+}
+
+int main()
+{
+	testPoolSplitLifetime();
+	testPoolConcatLifetime();
+	testHashedDuplicates();
+	testSnapshotConsistency();
+	printf("all tests passed\n");
+	return 0;
+}
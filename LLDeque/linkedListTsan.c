@@ -0,0 +1,195 @@
+/***********************************************************
+* Filename: linkedListTsan.c
+*
+* Overview:
+*   Thread test for linkedList.c's snapshots, meant to run
+*	under ThreadSanitizer; build and run with
+*		make -f makefileLLDequeBag tsan
+*
+*	One writer thread keeps the list holding a run of
+*	consecutive values, sliding it with linkedListAddBack and
+*	linkedListRemoveFront and now and then taking back its last
+*	value with linkedListRemoveBack. Every so often it takes a
+*	snapshot for each of four reader threads and hands it over
+*	with the run it should read. Each reader walks its snapshot
+*	while the writer keeps changing the list, checks that it
+*	reads exactly that run and releases it.
+*
+*	The target also builds with -DLINKED_LIST_STATS. Each reader
+*	creates and destroys a list of its own as soon as it takes a
+*	snapshot, so four destroys (and linkedListStatsDestroyed
+*	reads) update the process-wide totals with nothing ordering
+*	them but the totals' own lock.
+************************************************************/
+#include "linkedList.h"
+#include <assert.h>
+#include <pthread.h>
+#include <stdio.h>
+
+#define READERS 4
+#define RUN 5000				// values in the list between changes
+#define STEPS 200000			// slides of the run by one value
+#define SNAPSHOT_EVERY 499		// steps between rounds of snapshots
+
+// A snapshot on its way from the writer to a reader
+struct Handoff
+{
+	struct LinkedListSnapshot* snapshot;	// NULL when the slot is free
+	int first;								// value the snapshot should start with
+	int size;								// number of values it should read
+};
+
+static pthread_mutex_t handoffLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t handoffReady = PTHREAD_COND_INITIALIZER;
+static struct Handoff handoffs[READERS];
+static int writerDone;
+
+// What a reader has seen of one snapshot so far
+struct SnapshotCheck
+{
+	int next;		// value the next visit should see
+	int seen;
+};
+
+static void checkValue(TYPE value, void* ctx)
+{
+	struct SnapshotCheck* check = ctx;
+	assert(value == (TYPE)check->next);
+	check->next++;
+	check->seen++;
+}
+
+/**
+	Takes snapshots from its handoff slot until the writer is done,
+	checking and releasing each one.
+	param:	arg		reader number, a long cast to a pointer
+	ret:	number of snapshots checked, as a pointer
+ */
+static void* reader(void* arg)
+{
+	long id = (long)arg;
+	long checked = 0;
+
+	for (;;)
+	{
+		pthread_mutex_lock(&handoffLock);
+		while (handoffs[id].snapshot == 0 && !writerDone)
+		{
+			pthread_cond_wait(&handoffReady, &handoffLock);
+		}
+		struct Handoff handoff = handoffs[id];
+		handoffs[id].snapshot = 0;
+		pthread_mutex_unlock(&handoffLock);
+
+		if (handoff.snapshot == 0)
+		{
+			break;
+		}
+
+		/* a list of this thread's own, destroyed while others are too */
+		struct LinkedList* own = linkedListCreate();
+		linkedListAddBack(own, (TYPE)id);
+		linkedListDestroy(own);
+#ifdef LINKED_LIST_STATS
+		struct LinkedListStats totals;
+		linkedListStatsDestroyed(&totals);
+		assert(totals.calls[LINKED_LIST_OP_DESTROY] > 0);
+#endif
+
+		assert(linkedListSnapshotSize(handoff.snapshot) == handoff.size);
+		struct SnapshotCheck check = { handoff.first, 0 };
+		linkedListSnapshotForEach(handoff.snapshot, checkValue, &check);
+		assert(check.seen == handoff.size);
+		linkedListSnapshotRelease(handoff.snapshot);
+		checked++;
+	}
+	return (void*)checked;
+}
+
+/**
+	Slides the run of values in list and hands each reader snapshots of
+	it, replacing any a reader has not taken yet.
+ */
+static void writer(struct LinkedList* list)
+{
+	int first = 0;
+	int next = 0;
+	while (next < RUN)
+	{
+		linkedListAddBack(list, (TYPE)next++);
+	}
+
+	for (int step = 0; step < STEPS; step++)
+	{
+		linkedListAddBack(list, (TYPE)next++);
+		linkedListRemoveFront(list);
+		first++;
+
+		if (step % 7 == 0)
+		{
+			/* the back link is shared once a snapshot is live */
+			linkedListRemoveBack(list);
+			linkedListAddBack(list, (TYPE)(next - 1));
+		}
+
+		if (step % SNAPSHOT_EVERY == 0)
+		{
+			struct LinkedListSnapshot* untaken[READERS];
+			struct Handoff handoff = { 0, first, next - first };
+
+			pthread_mutex_lock(&handoffLock);
+			for (int id = 0; id < READERS; id++)
+			{
+				untaken[id] = handoffs[id].snapshot;
+				handoff.snapshot = linkedListSnapshot(list);
+				handoffs[id] = handoff;
+			}
+			pthread_cond_broadcast(&handoffReady);
+			pthread_mutex_unlock(&handoffLock);
+
+			for (int id = 0; id < READERS; id++)
+			{
+				if (untaken[id] != 0)
+				{
+					linkedListSnapshotRelease(untaken[id]);
+				}
+			}
+		}
+	}
+
+	pthread_mutex_lock(&handoffLock);
+	writerDone = 1;
+	pthread_cond_broadcast(&handoffReady);
+	pthread_mutex_unlock(&handoffLock);
+}
+
+int main()
+{
+	struct LinkedList* list = linkedListCreate();
+	pthread_t readers[READERS];
+	for (long i = 0; i < READERS; i++)
+	{
+		int created = pthread_create(&readers[i], 0, reader, (void*)i);
+		assert(created == 0);
+	}
+
+	writer(list);
+
+	long checked = 0;
+	for (int i = 0; i < READERS; i++)
+	{
+		void* result = 0;
+		pthread_join(readers[i], &result);
+		checked += (long)result;
+	}
+	assert(checked > 0);
+
+	/* the readers drain their slots before they exit */
+	for (int i = 0; i < READERS; i++)
+	{
+		assert(handoffs[i].snapshot == 0);
+	}
+	linkedListDestroy(list);
+	printf("all thread tests passed (%ld snapshots checked)\n", checked);
+	return 0;
+}
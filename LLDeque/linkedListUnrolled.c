@@ -0,0 +1,420 @@
+/***********************************************************
+* Filename: linkedListUnrolled.c
+*
+* Overview:
+*   This program is an unrolled linked list implementation of
+*	the deque and bag ADTs declared in linkedList.h. It is a
+*	drop-in replacement for linkedList.c, selected at build
+*	time with:
+*		make -f makefileLLDequeBag LIST_IMPL=linkedListUnrolled
+*
+*	Instead of one value per link, each chunk holds a small
+*	array of values (CHUNK_BYTES of payload) in the slots
+*	[front, back). The deque grows at the back by filling a
+*	chunk's free slots after back, and at the front by filling
+*	the free slots before front, so both ends stay O(1) and a
+*	traversal touches one chunk header per CHUNK_VALUES values.
+*
+*	Note that the capacity hint and LINKED_LIST_* flags are
+*	accepted for API compatibility but have no effect; bag
+*	lookups are always a front-to-back scan.
+************************************************************/
+#include "linkedList.h"
+#include <assert.h>
+#include <stdlib.h>
+#include <stdio.h>
+
+#ifndef FORMAT_SPECIFIER
+#define FORMAT_SPECIFIER "%d"
+#endif
+
+/* bytes of values held by each chunk */
+#ifndef CHUNK_BYTES
+#define CHUNK_BYTES 64
+#endif
+
+#define CHUNK_VALUES (CHUNK_BYTES / sizeof(TYPE) > 0 ? CHUNK_BYTES / sizeof(TYPE) : 1)
+
+// Double link holding up to CHUNK_VALUES values in [front, back)
+struct Chunk
+{
+	struct Chunk* next;
+	struct Chunk* prev;
+	int front;
+	int back;
+	TYPE values[CHUNK_VALUES];
+};
+
+// Unrolled double linked list
+struct LinkedList
+{
+	struct Chunk* first;
+	struct Chunk* last;
+	struct Chunk* spare;	// one emptied chunk kept to avoid malloc/free churn at a boundary
+	int size;
+};
+
+/**
+	Returns an unlinked chunk, reusing the list's spare chunk if any.
+	param: 	list 	struct LinkedList ptr
+	param:	start	initial front and back offset of the chunk
+	pre: 	list is not null
+	ret:	empty chunk with front == back == start
+ */
+static struct Chunk* allocChunk(struct LinkedList* list, int start)
+{
+	struct Chunk* chunk = list->spare;
+	if (chunk != 0)
+	{
+		list->spare = 0;
+	}
+	else
+	{
+		chunk = malloc(sizeof(struct Chunk));
+		assert(chunk != 0);
+	}
+
+	chunk->next = 0;
+	chunk->prev = 0;
+	chunk->front = start;
+	chunk->back = start;
+	return chunk;
+}
+
+/**
+	Unlinks an empty chunk from the list and frees it (or keeps it
+	as the spare chunk).
+	param: 	list 	struct LinkedList ptr
+	param:	chunk 	struct Chunk ptr
+	pre: 	chunk is in the list and holds no values
+	post:	chunk is no longer in the list
+ */
+static void removeChunk(struct LinkedList* list, struct Chunk* chunk)
+{
+	assert(chunk->front == chunk->back);
+
+	if (chunk->prev != 0)
+		chunk->prev->next = chunk->next;
+	else
+		list->first = chunk->next;
+
+	if (chunk->next != 0)
+		chunk->next->prev = chunk->prev;
+	else
+		list->last = chunk->prev;
+
+	if (list->spare == 0)
+		list->spare = chunk;
+	else
+		free(chunk);
+}
+
+/**
+	Allocates and initializes a list.
+	pre: 	none
+	post: 	memory allocated for new struct LinkedList ptr
+	return: list
+ */
+struct LinkedList* linkedListCreate()
+{
+	struct LinkedList* list = malloc(sizeof(struct LinkedList));
+	assert(list != 0);
+	list->first = 0;
+	list->last = 0;
+	list->spare = 0;
+	list->size = 0;
+	return list;
+}
+
+/**
+	Allocates and initializes a list; the capacity hint is ignored.
+	param:	capacity	expected number of values
+	return: list
+ */
+struct LinkedList* linkedListCreateWithCapacity(int capacity)
+{
+	(void)capacity;
+	return linkedListCreate();
+}
+
+/**
+	Allocates and initializes a list; the capacity hint and flags
+	are ignored.
+	param:	capacity	expected number of values
+	param:	flags		bitwise or of LINKED_LIST_* flags
+	return: list
+ */
+struct LinkedList* linkedListCreateWithFlags(int capacity, int flags)
+{
+	(void)flags;
+	return linkedListCreateWithCapacity(capacity);
+}
+
+/**
+	Deallocates every chunk in the list and frees the list itself.
+	param:	list 	struct LinkedList ptr
+	pre: 	list is not null
+	post: 	memory allocated to each chunk is freed
+			" " list " "
+ */
+void linkedListDestroy(struct LinkedList* list)
+{
+	assert(list != NULL);
+	while (list->first != 0)
+	{
+		struct Chunk* next = list->first->next;
+		free(list->first);
+		list->first = next;
+	}
+	free(list->spare);
+	free(list);
+}
+
+/**
+	Adds a new value to the front of the deque, starting a new
+	chunk when the first chunk has no free slot before front.
+	param: 	deque 	struct LinkedList ptr
+	param: 	value 	TYPE
+	pre: 	deque is not null
+	post: 	value is the deque's front
+ */
+void linkedListAddFront(struct LinkedList* deque, TYPE value)
+{
+	assert(deque != 0);
+
+	if (deque->first == 0 || deque->first->front == 0)
+	{
+		struct Chunk* chunk = allocChunk(deque, CHUNK_VALUES);
+		chunk->next = deque->first;
+		if (deque->first != 0)
+			deque->first->prev = chunk;
+		else
+			deque->last = chunk;
+		deque->first = chunk;
+	}
+
+	deque->first->values[--deque->first->front] = value;
+	deque->size += 1;
+}
+
+/**
+	Adds a new value to the back of the deque, starting a new
+	chunk when the last chunk has no free slot after back.
+	param: 	deque 	struct LinkedList ptr
+	param: 	value 	TYPE
+	pre: 	deque is not null
+	post: 	value is the deque's back
+ */
+void linkedListAddBack(struct LinkedList* deque, TYPE value)
+{
+	assert(deque != 0);
+
+	if (deque->last == 0 || deque->last->back == (int)CHUNK_VALUES)
+	{
+		struct Chunk* chunk = allocChunk(deque, 0);
+		chunk->prev = deque->last;
+		if (deque->last != 0)
+			deque->last->next = chunk;
+		else
+			deque->first = chunk;
+		deque->last = chunk;
+	}
+
+	deque->last->values[deque->last->back++] = value;
+	deque->size += 1;
+}
+
+/**
+	Returns the value at the front of the deque.
+	param: 	deque 	struct LinkedList ptr
+	pre:	deque is not null
+	pre:	deque is not empty
+	ret:	first value
+ */
+TYPE linkedListFront(struct LinkedList* deque)
+{
+	assert(deque != 0);
+	assert(deque->size > 0);
+
+	return deque->first->values[deque->first->front];
+}
+
+/**
+	Returns the value at the back of the deque.
+	param: 	deque 	struct LinkedList ptr
+	pre:	deque is not null
+	pre:	deque is not empty
+	ret:	last value
+ */
+TYPE linkedListBack(struct LinkedList* deque)
+{
+	assert(deque != 0);
+	assert(deque->size > 0);
+
+	return deque->last->values[deque->last->back - 1];
+}
+
+/**
+	Removes the value at the front of the deque, releasing the
+	first chunk once it is empty.
+	param: 	deque 	struct LinkedList ptr
+	pre:	deque is not null
+	pre:	deque is not empty
+ */
+void linkedListRemoveFront(struct LinkedList* deque)
+{
+	assert(deque != 0);
+	assert(deque->size > 0);
+
+	struct Chunk* chunk = deque->first;
+	chunk->front += 1;
+	deque->size -= 1;
+
+	if (chunk->front == chunk->back)
+		removeChunk(deque, chunk);
+}
+
+/**
+	Removes the value at the back of the deque, releasing the
+	last chunk once it is empty.
+	param: 	deque 	struct LinkedList ptr
+	pre:	deque is not null
+	pre:	deque is not empty
+ */
+void linkedListRemoveBack(struct LinkedList* deque)
+{
+	assert(deque != 0);
+	assert(deque->size > 0);
+
+	struct Chunk* chunk = deque->last;
+	chunk->back -= 1;
+	deque->size -= 1;
+
+	if (chunk->front == chunk->back)
+		removeChunk(deque, chunk);
+}
+
+/**
+	Returns 1 if the deque is empty and 0 otherwise.
+	param:	deque	struct LinkedList ptr
+	pre:	deque is not null
+	ret:	1 if its size is 0 (empty), otherwise 0 (not empty)
+ */
+int linkedListIsEmpty(struct LinkedList* deque)
+{
+	assert(deque != 0);
+	return deque->size == 0;
+}
+
+/**
+	Prints the values in the deque from front to back.
+	param:	deque	struct LinkedList ptr
+	pre:	deque is not null
+	ret:	outputs to the console the values from front to back;
+			if empty, prints msg that is empty
+ */
+void linkedListPrint(struct LinkedList* deque)
+{
+	assert(deque != 0);
+
+	if (linkedListIsEmpty(deque))
+	{
+		printf("Deque's list is empty...\n");
+		return;
+	}
+
+	printf("Printing the deque's list of values...\n");
+	for (struct Chunk* chunk = deque->first; chunk != 0; chunk = chunk->next)
+	{
+		for (int i = chunk->front; i < chunk->back; i++)
+		{
+			printf(FORMAT_SPECIFIER " ", chunk->values[i]);
+		}
+	}
+	printf("\n");
+}
+
+/**
+	Adds a value to the bag (at the front).
+	param:	bag		struct LinkedList ptr
+	param: 	value 	TYPE
+	pre: 	bag is not null
+ */
+void linkedListAdd(struct LinkedList* bag, TYPE value)
+{
+	linkedListAddFront(bag, value);
+}
+
+/**
+	Finds the first occurrence of a value in the bag.
+	param:	bag		struct LinkedList ptr
+	param: 	value 	TYPE
+	param:	slot	set to the value's offset within the returned chunk
+	pre: 	bag is not null
+	ret:	chunk holding the value, or NULL if not found
+ */
+static struct Chunk* findValue(struct LinkedList* bag, TYPE value, int* slot)
+{
+	for (struct Chunk* chunk = bag->first; chunk != 0; chunk = chunk->next)
+	{
+		for (int i = chunk->front; i < chunk->back; i++)
+		{
+			if (EQ(chunk->values[i], value))
+			{
+				*slot = i;
+				return chunk;
+			}
+		}
+	}
+	return 0;
+}
+
+/**
+	Returns 1 if the value is in the bag and 0 otherwise.
+	param:	bag		struct LinkedList ptr
+	param: 	value 	TYPE
+	pre: 	bag is not null
+	ret:	1 if value found; otherwise, 0
+ */
+int linkedListContains(struct LinkedList* bag, TYPE value)
+{
+	assert(bag != 0);
+
+	int slot;
+	return findValue(bag, value, &slot) != 0;
+}
+
+/**
+	Removes the first occurrence of the value, closing the gap by
+	shifting whichever side of its chunk is shorter.
+	param:	bag		struct LinkedList ptr
+	param: 	value 	TYPE
+	pre: 	bag is not null
+	post:	if value found, one occurrence is removed
+ */
+void linkedListRemove(struct LinkedList* bag, TYPE value)
+{
+	assert(bag != 0);
+
+	int slot;
+	struct Chunk* chunk = findValue(bag, value, &slot);
+	if (chunk == 0)
+		return;
+
+	if (slot - chunk->front < chunk->back - 1 - slot)
+	{
+		for (int i = slot; i > chunk->front; i--)
+			chunk->values[i] = chunk->values[i - 1];
+		chunk->front += 1;
+	}
+	else
+	{
+		for (int i = slot; i < chunk->back - 1; i++)
+			chunk->values[i] = chunk->values[i + 1];
+		chunk->back -= 1;
+	}
+	bag->size -= 1;
+
+	if (chunk->front == chunk->back)
+		removeChunk(bag, chunk);
+}
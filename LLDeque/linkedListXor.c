@@ -0,0 +1,435 @@
+/***********************************************************
+* Filename: linkedListXor.c
+*
+* Overview:
+*   This program is an XOR-linked implementation of the deque
+*	and bag ADTs declared in linkedList.h, for large deques
+*	where memory matters more than bidirectional cursors. It is
+*	a drop-in replacement for linkedList.c, selected at build
+*	time with:
+*		make -f makefileLLDequeBag LIST_IMPL=linkedListXor
+*
+*	Each link stores prev ^ next (as a uintptr_t) in a single
+*	word instead of two pointers. Given one neighbor of a link
+*	the other is recovered by XOR, so a traversal must start
+*	from an end and carry the previous link along. The list
+*	keeps a front and a back sentinel whose outer neighbor is
+*	NULL: a sentinel's word is simply its inner neighbor, so
+*	all deque operations remain O(1) from the sentinels.
+*
+*	As in linkedList.c, links are carved out of slabs and
+*	removed links are kept on a free list (threaded through
+*	their words) for reuse; destroying the list frees whole
+*	slabs. For an int TYPE a link takes 16 bytes instead of 24.
+*
+*	Note that the capacity hint sizes the first slab; the
+*	LINKED_LIST_* flags are accepted for API compatibility but
+*	have no effect, and bag lookups are a front-to-back scan.
+************************************************************/
+#include "linkedList.h"
+#include <assert.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+
+#ifndef FORMAT_SPECIFIER
+#define FORMAT_SPECIFIER "%d"
+#endif
+
+/* number of links in the first slab when no capacity hint is given */
+#ifndef SLAB_DEFAULT_CAPACITY
+#define SLAB_DEFAULT_CAPACITY 64
+#endif
+
+/* upper bound on the size of slabs added as the list grows */
+#ifndef SLAB_MAX_CAPACITY
+#define SLAB_MAX_CAPACITY 4096
+#endif
+
+// XOR link: both neighbors in one word
+struct Link
+{
+	TYPE value;
+	uintptr_t both;		// (uintptr_t)prev ^ (uintptr_t)next; next free link when unused
+};
+
+// Fixed-size block of links carved out front to back
+struct Slab
+{
+	struct Slab* next;
+	int capacity;
+	int used;
+	struct Link links[];
+};
+
+// XOR linked list with front and back sentinels
+struct LinkedList
+{
+	struct Link frontSentinel;
+	struct Link backSentinel;
+	struct Slab* slabs;			// current slab first
+	struct Link* freeLinks;
+	int size;
+};
+
+/**
+	Returns the neighbor of link that is not other.
+	param:	link	struct Link ptr
+	param:	other	one of link's neighbors (NULL beyond a sentinel)
+ */
+static struct Link* neighbor(const struct Link* link, const struct Link* other)
+{
+	return (struct Link*)(link->both ^ (uintptr_t)other);
+}
+
+/**
+	Replaces one of link's neighbors with another.
+	param:	link	struct Link ptr
+	param:	from	current neighbor of link
+	param:	to		new neighbor of link
+ */
+static void relink(struct Link* link, const struct Link* from, const struct Link* to)
+{
+	link->both ^= (uintptr_t)from ^ (uintptr_t)to;
+}
+
+/**
+	Allocates a new slab holding capacity links and makes it the
+	list's current slab.
+	param: 	list 		struct LinkedList ptr
+	param:	capacity 	number of links in the slab
+ */
+static void addSlab(struct LinkedList* list, int capacity)
+{
+	struct Slab* slab = malloc(sizeof(struct Slab) + (size_t)capacity * sizeof(struct Link));
+	assert(slab != 0);
+
+	slab->capacity = capacity;
+	slab->used = 0;
+	slab->next = list->slabs;
+	list->slabs = slab;
+}
+
+/**
+	Returns an unused link, from the free list if possible, otherwise
+	from the current slab (adding a new, larger slab when it is full).
+	param: 	list 	struct LinkedList ptr
+	ret:	link that is not part of the list
+ */
+static struct Link* allocLink(struct LinkedList* list)
+{
+	if (list->freeLinks != 0)
+	{
+		struct Link* link = list->freeLinks;
+		list->freeLinks = (struct Link*)link->both;
+		return link;
+	}
+
+	if (list->slabs->used == list->slabs->capacity)
+	{
+		int capacity = list->slabs->capacity * 2;
+		if (capacity > SLAB_MAX_CAPACITY)
+		{
+			capacity = list->slabs->capacity > SLAB_MAX_CAPACITY ? list->slabs->capacity : SLAB_MAX_CAPACITY;
+		}
+		addSlab(list, capacity);
+	}
+
+	return &list->slabs->links[list->slabs->used++];
+}
+
+/**
+	Links a new link with the given value in between two adjacent links.
+	param: 	list 	struct LinkedList ptr
+	param:	prev	struct Link ptr
+	param:	next	struct Link ptr, the neighbor of prev toward the back
+	param: 	value 	TYPE
+	post:	size is increased by 1
+ */
+static void addLinkBetween(struct LinkedList* list, struct Link* prev, struct Link* next, TYPE value)
+{
+	struct Link* node = allocLink(list);
+
+	node->value = value;
+	node->both = (uintptr_t)prev ^ (uintptr_t)next;
+	relink(prev, next, node);
+	relink(next, prev, node);
+	list->size += 1;
+}
+
+/**
+	Unlinks a link from between its two neighbors and puts it on the
+	free list.
+	param: 	list 	struct LinkedList ptr
+	param:	prev	neighbor of link toward the front
+	param:	link	struct Link ptr (not a sentinel)
+	post:	size is decreased by 1
+ */
+static void removeLinkAfter(struct LinkedList* list, struct Link* prev, struct Link* link)
+{
+	struct Link* next = neighbor(link, prev);
+
+	relink(prev, link, next);
+	relink(next, link, prev);
+	link->both = (uintptr_t)list->freeLinks;
+	list->freeLinks = link;
+	list->size -= 1;
+}
+
+/**
+	Allocates and initializes a list.
+	pre: 	none
+	post: 	memory allocated for new struct LinkedList ptr
+	return: list
+ */
+struct LinkedList* linkedListCreate()
+{
+	return linkedListCreateWithCapacity(0);
+}
+
+/**
+	Allocates and initializes a list whose first slab holds capacity
+	links, so the first capacity adds do not allocate.
+	param:	capacity	expected number of values
+	return: list
+ */
+struct LinkedList* linkedListCreateWithCapacity(int capacity)
+{
+	struct LinkedList* list = malloc(sizeof(struct LinkedList));
+	assert(list != 0);
+
+	/* each sentinel's only neighbor is the other */
+	list->frontSentinel.both = (uintptr_t)&list->backSentinel;
+	list->backSentinel.both = (uintptr_t)&list->frontSentinel;
+	list->slabs = 0;
+	list->freeLinks = 0;
+	list->size = 0;
+	addSlab(list, capacity > 0 ? capacity : SLAB_DEFAULT_CAPACITY);
+	return list;
+}
+
+/**
+	Allocates and initializes a list; the flags are ignored.
+	param:	capacity	expected number of values
+	param:	flags		bitwise or of LINKED_LIST_* flags
+	return: list
+ */
+struct LinkedList* linkedListCreateWithFlags(int capacity, int flags)
+{
+	(void)flags;
+	return linkedListCreateWithCapacity(capacity);
+}
+
+/**
+	Frees every slab of the list and the list itself.
+	param:	list 	struct LinkedList ptr
+	pre: 	list is not null
+ */
+void linkedListDestroy(struct LinkedList* list)
+{
+	assert(list != NULL);
+	while (list->slabs != 0)
+	{
+		struct Slab* next = list->slabs->next;
+		free(list->slabs);
+		list->slabs = next;
+	}
+	free(list);
+}
+
+/**
+	Adds a new value to the front of the deque.
+	param: 	deque 	struct LinkedList ptr
+	param: 	value 	TYPE
+	pre: 	deque is not null
+	post: 	value is the deque's front
+ */
+void linkedListAddFront(struct LinkedList* deque, TYPE value)
+{
+	assert(deque != 0);
+	struct Link* front = &deque->frontSentinel;
+	addLinkBetween(deque, front, neighbor(front, 0), value);
+}
+
+/**
+	Adds a new value to the back of the deque.
+	param: 	deque 	struct LinkedList ptr
+	param: 	value 	TYPE
+	pre: 	deque is not null
+	post: 	value is the deque's back
+ */
+void linkedListAddBack(struct LinkedList* deque, TYPE value)
+{
+	assert(deque != 0);
+	struct Link* back = &deque->backSentinel;
+	addLinkBetween(deque, neighbor(back, 0), back, value);
+}
+
+/**
+	Returns the value at the front of the deque.
+	param: 	deque 	struct LinkedList ptr
+	pre: 	deque is not null and not empty
+	ret: 	the front value
+ */
+TYPE linkedListFront(struct LinkedList* deque)
+{
+	assert(deque != 0);
+	assert(!linkedListIsEmpty(deque));
+	return neighbor(&deque->frontSentinel, 0)->value;
+}
+
+/**
+	Returns the value at the back of the deque.
+	param: 	deque 	struct LinkedList ptr
+	pre: 	deque is not null and not empty
+	ret: 	the back value
+ */
+TYPE linkedListBack(struct LinkedList* deque)
+{
+	assert(deque != 0);
+	assert(!linkedListIsEmpty(deque));
+	return neighbor(&deque->backSentinel, 0)->value;
+}
+
+/**
+	Removes the value at the front of the deque.
+	param: 	deque 	struct LinkedList ptr
+	pre: 	deque is not null and not empty
+	post: 	the front link is on the free list
+ */
+void linkedListRemoveFront(struct LinkedList* deque)
+{
+	assert(deque != 0);
+	assert(!linkedListIsEmpty(deque));
+	struct Link* front = &deque->frontSentinel;
+	removeLinkAfter(deque, front, neighbor(front, 0));
+}
+
+/**
+	Removes the value at the back of the deque. Walking from the back,
+	the back sentinel plays the part of the front neighbor.
+	param: 	deque 	struct LinkedList ptr
+	pre: 	deque is not null and not empty
+	post: 	the back link is on the free list
+ */
+void linkedListRemoveBack(struct LinkedList* deque)
+{
+	assert(deque != 0);
+	assert(!linkedListIsEmpty(deque));
+	struct Link* back = &deque->backSentinel;
+	removeLinkAfter(deque, back, neighbor(back, 0));
+}
+
+/**
+	Returns 1 if the deque is empty and 0 otherwise.
+	param:	deque	struct LinkedList ptr
+	pre:	deque is not null
+	ret:	1 if its size is 0 (empty), otherwise 0 (not empty)
+ */
+int linkedListIsEmpty(struct LinkedList* deque)
+{
+	assert(deque != 0);
+	return deque->size == 0;
+}
+
+/**
+	Prints the values in the deque from front to back.
+	param:	deque	struct LinkedList ptr
+	pre:	deque is not null
+	ret:	outputs to the console the values from front to back;
+			if empty, prints msg that is empty
+ */
+void linkedListPrint(struct LinkedList* deque)
+{
+	assert(deque != 0);
+
+	if (linkedListIsEmpty(deque))
+	{
+		printf("Deque's list is empty...\n");
+		return;
+	}
+
+	printf("Printing the deque's list of values...\n");
+	struct Link* prev = &deque->frontSentinel;
+	struct Link* link = neighbor(prev, 0);
+	while (link != &deque->backSentinel)
+	{
+		printf(FORMAT_SPECIFIER " ", link->value);
+		struct Link* next = neighbor(link, prev);
+		prev = link;
+		link = next;
+	}
+	printf("\n");
+}
+
+/**
+	Adds a value to the bag (at the front).
+	param:	bag		struct LinkedList ptr
+	param: 	value 	TYPE
+	pre: 	bag is not null
+ */
+void linkedListAdd(struct LinkedList* bag, TYPE value)
+{
+	linkedListAddFront(bag, value);
+}
+
+/**
+	Finds the first link holding a value, scanning from the front.
+	param:	bag		struct LinkedList ptr
+	param: 	value 	TYPE
+	param:	prev	set to the found link's front neighbor
+	pre: 	bag is not null
+	ret:	link holding the value, or NULL if not found
+ */
+static struct Link* findLink(struct LinkedList* bag, TYPE value, struct Link** prev)
+{
+	struct Link* before = &bag->frontSentinel;
+	struct Link* link = neighbor(before, 0);
+
+	while (link != &bag->backSentinel)
+	{
+		if (EQ(link->value, value))
+		{
+			*prev = before;
+			return link;
+		}
+		struct Link* next = neighbor(link, before);
+		before = link;
+		link = next;
+	}
+	return 0;
+}
+
+/**
+	Returns 1 if the value is in the bag and 0 otherwise.
+	param:	bag		struct LinkedList ptr
+	param: 	value 	TYPE
+	pre: 	bag is not null
+	ret:	1 if value found; otherwise, 0
+ */
+int linkedListContains(struct LinkedList* bag, TYPE value)
+{
+	assert(bag != 0);
+
+	struct Link* prev;
+	return findLink(bag, value, &prev) != 0;
+}
+
+/**
+	Removes the first occurrence of the value.
+	param:	bag		struct LinkedList ptr
+	param: 	value 	TYPE
+	pre: 	bag is not null
+	post:	if value found, one occurrence is removed
+ */
+void linkedListRemove(struct LinkedList* bag, TYPE value)
+{
+	assert(bag != 0);
+
+	struct Link* prev;
+	struct Link* link = findLink(bag, value, &prev);
+	if (link != 0)
+	{
+		removeLinkAfter(bag, prev, link);
+	}
+}
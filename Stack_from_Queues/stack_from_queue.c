@@ -34,6 +34,10 @@
 *	pointer that point to first/last link respectively. Each stack
 *	has two queue pointers.
 *
+*	The CreateWithAllocator constructors take every link,
+*	sentinel and header from the caller's allocator (see
+*	allocator.h), e.g. an arena that is destroyed in one shot.
+*
 * Usage:
 * 	1) gcc -g Wall -std=c99 -o stack_from_queue stack_from_queue
 *	2) ./stack_from_queue 
@@ -41,6 +45,7 @@
 #include <assert.h>
 #include <stdlib.h>
 #include <stdio.h>
+#include "../allocator.h"
 
 #ifndef TYPE
 #define TYPE int
@@ -56,12 +61,14 @@ struct Link {
 struct Queue {
 	struct Link* head;
 	struct Link* tail;
+	struct Allocator allocator;		// source of the queue and its links
 };
 
 // Stack with two Queue instances
 struct Stack {
 	struct Queue* q1;
 	struct Queue* q2;
+	struct Allocator allocator;		// source of the stack (and its queues)
 };
 
 /* FIXME: You will write this function */
@@ -81,7 +88,8 @@ void listQueueInit(struct Queue* queue)
 	assert(queue != 0);
 
 	/* allocate memory for the queue's sentinel */
-	struct Link* sentinel = (struct Link*)malloc(sizeof(struct Link));
+	struct Link* sentinel = queue->allocator.alloc(queue->allocator.context, sizeof(struct Link));
+	assert(sentinel != NULL);
 	sentinel->value = '\0';
 	sentinel->next = NULL;
 
@@ -90,6 +98,28 @@ void listQueueInit(struct Queue* queue)
 	queue->tail = sentinel;
 }
 
+/**
+	Allocates and initializes a queue whose links, sentinel and
+	header come from the given allocator.
+	param:	allocator	struct Allocator ptr, copied; NULL for malloc
+	pre: 	none
+	post: 	memory allocated for new struct Queue ptr
+			queue init (call to _initQueue func)
+	return: queue
+ */
+struct Queue* listQueueCreateWithAllocator(const struct Allocator* allocator)
+{
+	struct Allocator source = allocator != NULL ? *allocator : allocatorMalloc();
+	assert(source.alloc != NULL && source.free != NULL);
+
+	/* allocate memory for the queue */
+	struct Queue* queue = source.alloc(source.context, sizeof(struct Queue));
+	assert(queue != NULL);
+	queue->allocator = source;
+	listQueueInit(queue);
+	return queue;
+}
+
 /* FIXME: You will write this function */
 /**
 	Allocates and initializes a queue.
@@ -100,9 +130,7 @@ void listQueueInit(struct Queue* queue)
  */
 struct Queue* listQueueCreate() 
 {
-	/* allocate memory for the queue */
-	struct Queue* queue = (struct Queue*)malloc(sizeof(struct Queue));
-	listQueueInit(queue);
+	return listQueueCreateWithAllocator(NULL);
 }
 
 /* FIXME: You will write this function */
@@ -112,7 +140,7 @@ struct Queue* listQueueCreate()
 	param: 	value 	TYPE
 	pre: 	queue is not null
 	post: 	link is created with given value 
-			link is added before current last link (pointed to by queue tail)
+			link is added after current last link (pointed to by queue tail)
  */
 void listQueueAddBack (struct Queue* queue, TYPE value) 
 {
@@ -120,19 +148,14 @@ void listQueueAddBack (struct Queue* queue, TYPE value)
 	assert(queue != 0);
 
 	/* initialize & allocate memory for the new node/link */
-	struct Link* newNode = (struct Link*)malloc(sizeof(struct Link));
+	struct Link* newNode = queue->allocator.alloc(queue->allocator.context, sizeof(struct Link));
+	assert(newNode != NULL);
 	newNode->value = value;
 	newNode->next = NULL;
 
-	/* find the last node/link in the queue */
-	struct Link* temp = queue->head;
-	while (temp->next != NULL)
-	{
-		temp = temp->next;
-	}
-
-	/* insert the new node & update pointers */
-	temp->next = newNode;
+	/* insert the new node after the last one (the sentinel if empty) & update pointers */
+	assert(queue->tail->next == NULL);
+	queue->tail->next = newNode;
 	queue->tail = newNode;
 }
 
@@ -175,14 +198,47 @@ TYPE listQueueRemoveFront(struct Queue* queue)
 	/* capture the value of the node/link that will be removed */
 	TYPE val = temp->value;
 
-	/* update pointers & free temp's memory */
+	/* update pointers & free temp's memory; an emptied queue's tail is the sentinel again */
 	queue->head->next = temp->next;
-	free(temp);
+	if (queue->tail == temp)
+	{
+		queue->tail = queue->head;
+	}
+	queue->allocator.free(queue->allocator.context, temp, sizeof(struct Link));
 
 	/* return the value of the *removed* node/link */
 	return val;
 }
 
+/**
+	Moves the link at the front of one queue to the back of another,
+	as listQueueRemoveFront followed by listQueueAddBack would, but
+	without freeing the link and allocating a new one.
+	param: 	from 	struct Queue ptr
+	param: 	to 		struct Queue ptr, with the same allocator as from
+	pre:	from and to are not null
+	pre:	from is not empty
+	post:	from's first link is the last link of to
+ */
+static void listQueueMoveFront(struct Queue* from, struct Queue* to)
+{
+	assert(from != NULL && to != NULL);
+	assert(from->head->next != NULL);
+
+	/* unlink the first node/link; an emptied queue's tail is the sentinel again */
+	struct Link* link = from->head->next;
+	from->head->next = link->next;
+	if (from->tail == link)
+	{
+		from->tail = from->head;
+	}
+
+	/* relink it after to's last link */
+	link->next = NULL;
+	to->tail->next = link;
+	to->tail = link;
+}
+
 /* FIXME: You will write this function */
 /**
 	Returns 1 if the queue is empty and 0 otherwise.
@@ -226,30 +282,35 @@ void listQueueDestroy(struct Queue* queue)
 	while(!listQueueIsEmpty(queue)) {
 		listQueueRemoveFront(queue);
 	}
-	free(queue->head);
-	free(queue);
+	struct Allocator allocator = queue->allocator;
+	allocator.free(allocator.context, queue->head, sizeof(struct Link));
+	allocator.free(allocator.context, queue, sizeof(struct Queue));
 	queue = NULL;
 
 }
 
-/* FIXME: You will write this function */
 /**
-	Allocates and initializes a stack that is comprised of two 
-	instances of Queue data structures.
+	Allocates and initializes a stack whose two queues, and every
+	link in them, come from the given allocator.
+	param:	allocator	struct Allocator ptr, copied; NULL for malloc
 	pre: 	none
 	post: 	memory allocated for new struct Stack ptr
-			stack q1 Queue instance init (call to queueCreate func)
-			stack q2 Queue instance init (call to queueCreate func)
+			stack q1 and q2 Queue instances init with the allocator
 	return: stack
  */
-struct Stack* listStackFromQueuesCreate() 
+struct Stack* listStackFromQueuesCreateWithAllocator(const struct Allocator* allocator)
 {
+	struct Allocator source = allocator != NULL ? *allocator : allocatorMalloc();
+	assert(source.alloc != NULL && source.free != NULL);
+
 	/* allocate stack's memory */
-	struct Stack* stack = (struct Stack*)malloc(sizeof(struct Stack));
+	struct Stack* stack = source.alloc(source.context, sizeof(struct Stack));
+	assert(stack != NULL);
+	stack->allocator = source;
 
 	/* initialize q1 & q2 within the stack */
-	struct Queue* q1 = listQueueCreate();
-	struct Queue* q2 = listQueueCreate();
+	struct Queue* q1 = listQueueCreateWithAllocator(&source);
+	struct Queue* q2 = listQueueCreateWithAllocator(&source);
 
 	/* update stack pointers to point to the newly initialized queues */
 	stack->q1 = q1;
@@ -257,7 +318,22 @@ struct Stack* listStackFromQueuesCreate()
 
 	/* return the stack */
 	return stack;
-};
+}
+
+/* FIXME: You will write this function */
+/**
+	Allocates and initializes a stack that is comprised of two 
+	instances of Queue data structures.
+	pre: 	none
+	post: 	memory allocated for new struct Stack ptr
+			stack q1 Queue instance init (call to queueCreate func)
+			stack q2 Queue instance init (call to queueCreate func)
+	return: stack
+ */
+struct Stack* listStackFromQueuesCreate() 
+{
+	return listStackFromQueuesCreateWithAllocator(NULL);
+}
 
 /**
 	Deallocates every link in both queues contained in the stack,
@@ -279,7 +355,7 @@ void listStackDestroy(struct Stack* stack)
 	assert(stack->q1 != NULL && stack->q2 != NULL);
 	listQueueDestroy(stack->q1);
 	listQueueDestroy(stack->q2);
-	free(stack);
+	stack->allocator.free(stack->allocator.context, stack, sizeof(struct Stack));
 	stack = NULL;
 }
 
@@ -335,12 +411,15 @@ void listSwapStackQueues(struct Stack* stack)
 	Then while Queue q1 isn't empty, the first link of the queue is 
 	dequeued/removed and added to the back of Queue q2, so that in
 	the end, Queue q2 has the new order to represent the stack properly
-	with the new value at the front of the queue.
+	with the new value at the front of the queue. The links of q1
+	are moved rather than freed and reallocated, so a push allocates
+	one link; on an arena, whose free does nothing, n pushes take n
+	links rather than n(n+1)/2.
 	param: 	stack 	struct LinkedList ptr
 	param: 	value 	TYPE
 	pre: 	stack is not null
 	post: 	new link is created w/ given value and added to end of q2
-			the first link of q1 is removed and added to end of q2 until
+			the first link of q1 is moved to the end of q2 until
 			it's empty
 			q1 and q2 are swapped
  */
@@ -352,10 +431,10 @@ void listStackPush(struct Stack* stack, TYPE value)
 	/* adds the new value to the back of q2 */
 	listQueueAddBack(stack->q2, value);
 
-	/* moves all nodes/links/values from q1 -> q2 */
+	/* moves all nodes/links from q1 -> q2 */
 	while (stack->q1->head->next != NULL)
 	{
-		listQueueAddBack(stack->q2, listQueueRemoveFront(stack->q1));
+		listQueueMoveFront(stack->q1, stack->q2);
 	}
 
 	/* swap stack pointers between queues */
@@ -448,6 +527,18 @@ int main()
 
 	listStackDestroy(s);
 
+	printf("\nstack on an arena, pushing 0-99...\n");
+	struct Arena* arena = arenaCreate(0);
+	struct Allocator allocator = arenaAllocator(arena);
+	s = listStackFromQueuesCreateWithAllocator(&allocator);
+	for(int i = 0; i < 100; i++) {
+		listStackPush(s, i);
+	}
+	assertTrue(listStackPop(s) == 99, "popping; val == 99");
+	assertTrue(listStackTop(s) == 98, "top val == 98\t");
+	assertTrue(arena->blocks->next == NULL, "pushes reuse links; one arena block");
+	arenaDestroy(arena);	// frees the stack, its queues and links at once
+
 	return 0;
 }
 
@@ -0,0 +1,384 @@
+/***********************************************************
+* Filename: allocator.h
+*
+* Overview:
+*   Allocator interface for the containers in this repository
+*	(LinkedList, CircularList and the Queue/Stack of
+*	stack_from_queue.c). Their *CreateWithAllocator
+*	constructors take a struct Allocator, a small vtable of
+*	alloc and free functions plus a context pointer passed to
+*	both, and draw every link, sentinel and header from it.
+*	free is also given the size that was requested, for
+*	allocators that keep size classes. Passing NULL (or using
+*	the plain constructors) means malloc/free.
+*
+*	Every file that includes this header gets its own copy of
+*	the static inline functions, so an allocator cannot be
+*	recognized by its function addresses across files. The
+*	malloc allocator is marked instead (isMalloc), and
+*	allocatorSame compares allocators with that in mind.
+*
+*	An Arena is a bump allocator: allocations are carved in
+*	order out of large blocks and free does nothing. Each new
+*	block is twice the size of the last, so arenaDestroy frees
+*	a handful of blocks (one, if the first block was sized to
+*	fit) however many allocations were made. Containers built
+*	on an arena may simply be abandoned; destroying or
+*	resetting the arena releases them in one shot. Each
+*	allocation is aligned only as far as its size requires (up
+*	to ARENA_ALIGNMENT), so consecutively allocated links of a
+*	container sit back to back in memory.
+*
+*	arenaCreateHuge makes an arena whose blocks are mapped with
+*	mmap in whole 2 MiB huge pages, so that traversing tens of
+*	millions of links needs a few hundred TLB entries rather
+*	than tens of thousands. It asks for explicit huge pages
+*	(MAP_HUGETLB) first, then for transparent ones on a 2 MiB
+*	aligned mapping (madvise MADV_HUGEPAGE), and falls back to
+*	ordinary pages if neither is available; arenaPageKind
+*	reports which one the arena got. The mmap path needs
+*	<sys/mman.h>'s Linux extensions, so define _DEFAULT_SOURCE
+*	(or _GNU_SOURCE) in the file that calls arenaCreateHuge;
+*	without them it makes an ordinary arena. Blocks are
+*	released through the arena itself, so other files may
+*	allocate from, reset or destroy it either way.
+*
+*	Like intrusiveList.h, everything here is static inline, so
+*	the header needs no object file of its own.
+************************************************************/
+#ifndef ALLOCATOR_H
+#define ALLOCATOR_H
+
+#include <assert.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+/* bytes in an arena's first block when no size is given */
+#ifndef ARENA_DEFAULT_BLOCK_SIZE
+#define ARENA_DEFAULT_BLOCK_SIZE 65536
+#endif
+
+/* largest alignment given to an arena allocation (power of 2) */
+#define ARENA_ALIGNMENT 16
+
+/* size of the huge pages arenaCreateHuge maps blocks in */
+#ifndef ARENA_HUGE_PAGE_SIZE
+#define ARENA_HUGE_PAGE_SIZE ((size_t)2 << 20)
+#endif
+
+/* what an arena's most recent block is backed by (arenaPageKind) */
+#define ARENA_PAGES_NORMAL 0			// malloc, or mmap without huge pages
+#define ARENA_PAGES_TRANSPARENT 1		// mmap advised MADV_HUGEPAGE
+#define ARENA_PAGES_HUGETLB 2			// mmap with MAP_HUGETLB
+
+// Allocation vtable: context is passed to both functions
+struct Allocator
+{
+	void* (*alloc)(void* context, size_t size);			// NULL if out of memory
+	void (*free)(void* context, void* ptr, size_t size);	// size as passed to alloc
+	void* context;
+	int isMalloc;		// nonzero only from allocatorMalloc: alloc/free are malloc/free
+};
+
+// Chunk of arena memory, handed out front to back
+struct ArenaBlock
+{
+	struct ArenaBlock* next;	// previous (smaller) block
+	size_t size;				// bytes of data
+	size_t used;
+	union { long double ld; long long ll; void* p; } data[];	// maximally aligned
+};
+
+// Bump allocator over a chain of doubling blocks
+struct Arena
+{
+	struct ArenaBlock* blocks;	// current (largest) block first
+	size_t firstBlockSize;
+	struct ArenaBlock* (*newBlock)(struct Arena* arena, size_t size);	// NULL if out of memory
+	void (*releaseBlock)(struct ArenaBlock* block);
+	int pageKind;				// ARENA_PAGES_* of the newest block
+};
+
+static inline void* mallocAlloc(void* context, size_t size)
+{
+	(void)context;
+	return malloc(size);
+}
+
+static inline void mallocFree(void* context, void* ptr, size_t size)
+{
+	(void)context;
+	(void)size;
+	free(ptr);
+}
+
+/**
+	Returns the allocator the containers use by default.
+	ret:	allocator calling malloc and free
+ */
+static inline struct Allocator allocatorMalloc(void)
+{
+	struct Allocator allocator = { mallocAlloc, mallocFree, 0, 1 };
+	return allocator;
+}
+
+/**
+	Returns whether memory from one allocator may be freed by the
+	other: both call malloc/free, or both are the same functions
+	over the same context. Allocators made by arenaAllocator in
+	different files compare unequal, which only costs a copy.
+	param:	a	struct Allocator ptr
+	param:	b	struct Allocator ptr
+	pre:	a and b are not null
+	ret:	1 if they are interchangeable, otherwise 0
+ */
+static inline int allocatorSame(const struct Allocator* a, const struct Allocator* b)
+{
+	assert(a != 0 && b != 0);
+	if (a->isMalloc || b->isMalloc)
+	{
+		return a->isMalloc && b->isMalloc;
+	}
+	return a->alloc == b->alloc && a->free == b->free && a->context == b->context;
+}
+
+static inline struct ArenaBlock* arenaMallocBlock(struct Arena* arena, size_t size)
+{
+	struct ArenaBlock* block = malloc(sizeof(struct ArenaBlock) + size);
+	if (block != 0)
+	{
+		block->size = size;
+		arena->pageKind = ARENA_PAGES_NORMAL;
+	}
+	return block;
+}
+
+static inline void arenaFreeBlock(struct ArenaBlock* block)
+{
+	free(block);
+}
+
+/**
+	Allocates an empty arena. No memory is reserved until the first
+	allocation.
+	param:	firstBlockSize	bytes in the first block (0 uses the default)
+	ret:	arena
+ */
+static inline struct Arena* arenaCreate(size_t firstBlockSize)
+{
+	struct Arena* arena = malloc(sizeof(struct Arena));
+	assert(arena != 0);
+
+	arena->blocks = 0;
+	arena->firstBlockSize = firstBlockSize > 0 ? firstBlockSize : ARENA_DEFAULT_BLOCK_SIZE;
+	arena->newBlock = arenaMallocBlock;
+	arena->releaseBlock = arenaFreeBlock;
+	arena->pageKind = ARENA_PAGES_NORMAL;
+	return arena;
+}
+
+#if defined(__linux__) && defined(MAP_ANONYMOUS)
+/**
+	Maps a block of at least size data bytes in whole huge pages:
+	explicit huge pages if the system has any reserved, otherwise a
+	huge page aligned mapping advised to use transparent huge pages.
+	param:	arena	struct Arena ptr, whose pageKind is updated
+	param:	size	data bytes needed
+	ret:	block, or NULL if the mapping failed
+ */
+static inline struct ArenaBlock* arenaMapBlock(struct Arena* arena, size_t size)
+{
+	size_t length = (sizeof(struct ArenaBlock) + size + ARENA_HUGE_PAGE_SIZE - 1) & ~(ARENA_HUGE_PAGE_SIZE - 1);
+	void* map = MAP_FAILED;
+	int kind = ARENA_PAGES_NORMAL;
+
+#ifdef MAP_HUGETLB
+	map = mmap(0, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+	kind = ARENA_PAGES_HUGETLB;
+#endif
+	if (map == MAP_FAILED)
+	{
+		/* over-map by one huge page and trim, so the block starts on a huge page */
+		char* raw = mmap(0, length + ARENA_HUGE_PAGE_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		if (raw == MAP_FAILED)
+		{
+			return 0;
+		}
+		size_t head = (ARENA_HUGE_PAGE_SIZE - ((uintptr_t)raw & (ARENA_HUGE_PAGE_SIZE - 1))) & (ARENA_HUGE_PAGE_SIZE - 1);
+		if (head > 0)
+		{
+			munmap(raw, head);
+		}
+		munmap(raw + head + length, ARENA_HUGE_PAGE_SIZE - head);
+		map = raw + head;
+
+		kind = ARENA_PAGES_NORMAL;
+#ifdef MADV_HUGEPAGE
+		if (madvise(map, length, MADV_HUGEPAGE) == 0)
+		{
+			kind = ARENA_PAGES_TRANSPARENT;
+		}
+#endif
+	}
+
+	struct ArenaBlock* block = map;
+	block->size = length - sizeof(struct ArenaBlock);
+	arena->pageKind = kind;
+	return block;
+}
+
+static inline void arenaUnmapBlock(struct ArenaBlock* block)
+{
+	munmap(block, sizeof(struct ArenaBlock) + block->size);
+}
+#endif
+
+/**
+	Allocates an empty arena whose blocks are mapped in huge pages,
+	or an ordinary arena where mmap's huge page support is not
+	compiled in (see the overview). Every block is a whole number
+	of huge pages; a block that cannot be mapped fails the
+	allocation (arenaAlloc returns NULL).
+	param:	firstBlockSize	bytes in the first block (0 uses one huge page)
+	ret:	arena
+ */
+static inline struct Arena* arenaCreateHuge(size_t firstBlockSize)
+{
+	struct Arena* arena = arenaCreate(firstBlockSize > 0 ? firstBlockSize : ARENA_HUGE_PAGE_SIZE);
+#if defined(__linux__) && defined(MAP_ANONYMOUS)
+	arena->newBlock = arenaMapBlock;
+	arena->releaseBlock = arenaUnmapBlock;
+#endif
+	return arena;
+}
+
+/**
+	Returns what the arena's newest block is backed by.
+	param:	arena	struct Arena ptr
+	ret:	ARENA_PAGES_NORMAL, ARENA_PAGES_TRANSPARENT or ARENA_PAGES_HUGETLB
+ */
+static inline int arenaPageKind(struct Arena* arena)
+{
+	assert(arena != 0);
+	return arena->pageKind;
+}
+
+/**
+	Returns size bytes from the arena's current block, starting a
+	block twice as large (or larger, for a big request) when it is
+	full. The memory is aligned to the largest power of 2 that
+	divides size, up to ARENA_ALIGNMENT, so that e.g. 24-byte links
+	are packed 24 bytes apart. Used as an Allocator's alloc.
+	param:	context	struct Arena ptr
+	param:	size	bytes requested
+	ret:	suitably aligned memory, or NULL if out of memory
+ */
+static inline void* arenaAlloc(void* context, size_t size)
+{
+	struct Arena* arena = context;
+	size_t alignment = size & (~size + 1);
+	if (alignment == 0 || alignment > ARENA_ALIGNMENT)
+	{
+		alignment = ARENA_ALIGNMENT;
+	}
+
+	struct ArenaBlock* block = arena->blocks;
+	size_t offset = block != 0 ? (block->used + alignment - 1) & ~(alignment - 1) : 0;
+	if (block == 0 || offset > block->size || block->size - offset < size)
+	{
+		size_t blockSize = block != 0 ? block->size * 2 : arena->firstBlockSize;
+		while (blockSize < size)
+		{
+			blockSize *= 2;
+		}
+
+		block = arena->newBlock(arena, blockSize);
+		if (block == 0)
+		{
+			return 0;
+		}
+		block->next = arena->blocks;
+		block->used = 0;
+		arena->blocks = block;
+		offset = 0;
+	}
+
+	void* ptr = (char*)block->data + offset;
+	block->used = offset + size;
+	return ptr;
+}
+
+/**
+	Does nothing: arena memory is only released all at once. Used
+	as an Allocator's free.
+ */
+static inline void arenaFree(void* context, void* ptr, size_t size)
+{
+	(void)context;
+	(void)ptr;
+	(void)size;
+}
+
+/**
+	Returns an allocator drawing from the arena.
+	param:	arena	struct Arena ptr
+	pre:	arena is not null
+	ret:	allocator whose context is arena
+ */
+static inline struct Allocator arenaAllocator(struct Arena* arena)
+{
+	assert(arena != 0);
+	struct Allocator allocator = { arenaAlloc, arenaFree, arena, 0 };
+	return allocator;
+}
+
+/**
+	Releases everything allocated from the arena but keeps its
+	largest block for reuse, so an arena reset after each request
+	settles into one block and no further calls to malloc.
+	param:	arena	struct Arena ptr
+	pre:	arena is not null
+	post:	memory previously returned by the arena is invalid
+ */
+static inline void arenaReset(struct Arena* arena)
+{
+	assert(arena != 0);
+
+	struct ArenaBlock* block = arena->blocks;
+	if (block == 0)
+	{
+		return;
+	}
+	while (block->next != 0)
+	{
+		struct ArenaBlock* next = block->next->next;
+		arena->releaseBlock(block->next);
+		block->next = next;
+	}
+	block->used = 0;
+}
+
+/**
+	Frees the arena and every block of memory it handed out.
+	param:	arena	struct Arena ptr
+	pre:	arena is not null
+	post:	memory previously returned by the arena is invalid
+ */
+static inline void arenaDestroy(struct Arena* arena)
+{
+	assert(arena != 0);
+
+	while (arena->blocks != 0)
+	{
+		struct ArenaBlock* next = arena->blocks->next;
+		arena->releaseBlock(arena->blocks);
+		arena->blocks = next;
+	}
+	free(arena);
+}
+
+#endif
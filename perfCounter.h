@@ -0,0 +1,97 @@
+/***********************************************************
+* Filename: perfCounter.h
+*
+* Overview:
+*   dTLB load miss counter shared by the benchmarks
+*	(linkedListBench.c, circularListBench.c). The counter is
+*	read with Linux's perf_event_open and counts this thread's
+*	user-space misses between counterStart and counterStop.
+*	Where perf events are unavailable (another OS, or a
+*	sandbox that forbids them) dtlbCounterOpen returns -1, the
+*	count is -1 and perValue prints "n/a", so a benchmark can
+*	report its timings either way.
+*
+*	syscall needs _DEFAULT_SOURCE (or _GNU_SOURCE), defined in
+*	the file that includes this header. Like allocator.h,
+*	everything here is static inline, so the header needs no
+*	object file of its own.
+************************************************************/
+#ifndef PERF_COUNTER_H
+#define PERF_COUNTER_H
+
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#endif
+
+/**
+	Opens a counter of this thread's user-space dTLB load misses,
+	initially stopped.
+	ret:	file descriptor, or -1 if perf events are unavailable
+ */
+static inline int dtlbCounterOpen(void)
+{
+#if defined(__linux__) && defined(SYS_perf_event_open)
+	struct perf_event_attr attr;
+	memset(&attr, 0, sizeof(attr));
+	attr.size = sizeof(attr);
+	attr.type = PERF_TYPE_HW_CACHE;
+	attr.config = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+		| (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+	attr.disabled = 1;
+	attr.exclude_kernel = 1;
+	attr.exclude_hv = 1;
+	return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+#else
+	return -1;
+#endif
+}
+
+/**
+	Zeroes and starts the counter (if it is open).
+ */
+static inline void counterStart(int fd)
+{
+#ifdef __linux__
+	if (fd >= 0)
+	{
+		ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+		ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+	}
+#endif
+}
+
+/**
+	Stops the counter and returns its count, or -1 if it is not open.
+ */
+static inline long long counterStop(int fd)
+{
+	long long count = -1;
+#ifdef __linux__
+	if (fd >= 0)
+	{
+		ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+		if (read(fd, &count, sizeof(count)) != (ssize_t)sizeof(count))
+			count = -1;
+	}
+#endif
+	return count;
+}
+
+/**
+	Formats count / n, or "n/a" for a count of -1, into text.
+ */
+static inline const char* perValue(char* text, size_t size, long long count, long n)
+{
+	if (count < 0)
+		snprintf(text, size, "n/a");
+	else
+		snprintf(text, size, "%.3f", (double)count / n);
+	return text;
+}
+
+#endif
@@ -0,0 +1,78 @@
+/***********************************************************
+* Filename: printBuffer.h
+*
+* Overview:
+*   Buffered text output shared by the lists' PrintFile and
+*	PrintBuffer functions (linkedList.c, circularList.c). Text
+*	is appended to a struct PrintBuffer, which either gathers
+*	it for a FILE and hands it over in large blocks, or fills a
+*	caller's buffer, dropping (but still counting) what does
+*	not fit, as snprintf does.
+*
+*	A FILE write that comes up short marks the buffer failed;
+*	later text is counted but no longer written, so a PrintFile
+*	can report the failure once it is done.
+*
+*	Like allocator.h, everything here is static inline, so the
+*	header needs no object file of its own.
+************************************************************/
+#ifndef PRINT_BUFFER_H
+#define PRINT_BUFFER_H
+
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+/* bytes of text gathered before each write to a FILE */
+#ifndef PRINT_BUFFER_SIZE
+#define PRINT_BUFFER_SIZE 65536
+#endif
+
+// Destination of buffered print output: a FILE or a caller's buffer
+struct PrintBuffer
+{
+	FILE* out;			// flushed to when data fills up; NULL for a caller's buffer
+	char* data;
+	size_t size;
+	size_t used;		// chars currently held in data
+	size_t total;		// chars produced so far, including flushed ones
+	int failed;			// nonzero once a write to out came up short
+};
+
+/**
+	Hands the buffered text to the FILE, if printing to one. A short
+	write marks the buffer failed and drops the text.
+	param:	pb	struct PrintBuffer ptr
+ */
+static inline void printBufferFlush(struct PrintBuffer* pb)
+{
+	if (pb->out != 0 && pb->used > 0)
+	{
+		if (!pb->failed && fwrite(pb->data, 1, pb->used, pb->out) != pb->used)
+		{
+			pb->failed = 1;
+		}
+		pb->used = 0;
+	}
+}
+
+/**
+	Appends text to the print buffer. For a caller's buffer, text
+	that does not fit is dropped but still counted.
+	param:	pb		struct PrintBuffer ptr
+	param:	text	chars to append
+	param:	len		number of chars
+ */
+static inline void printBufferPut(struct PrintBuffer* pb, const char* text, size_t len)
+{
+	if (pb->out != 0 && pb->used + len > pb->size)
+	{
+		printBufferFlush(pb);
+	}
+	size_t fits = (len < pb->size - pb->used) ? len : pb->size - pb->used;
+	memcpy(pb->data + pb->used, text, fits);
+	pb->used += fits;
+	pb->total += len;
+}
+
+#endif